@@ -0,0 +1,353 @@
+// compression.h
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+#include "core_framework.h"
+#include "file_io.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+
+// ѹʽ֧ǿѡģʱ DATAPLATFORM_WITH_ZLIB -lz
+//  DATAPLATFORM_WITH_ZSTD -lzstdŻöӦĽ
+// ʱ isCompressionSupported() ѯδõĸʽڴʱ׳ PlatformException
+#ifdef DATAPLATFORM_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef DATAPLATFORM_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace DataPlatform {
+
+enum class Compression {
+    NONE,
+    GZIP,
+    ZSTD
+};
+
+// ļͷħʶѹʽ
+inline Compression detectCompression(const char* data, size_t size) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    if (size >= 2 && bytes[0] == 0x1f && bytes[1] == 0x8b) {
+        return Compression::GZIP;
+    }
+    if (size >= 4 && bytes[0] == 0x28 && bytes[1] == 0xb5 && bytes[2] == 0x2f && bytes[3] == 0xfd) {
+        return Compression::ZSTD;
+    }
+    // Skippable frame, written first by e.g. pzstd
+    if (size >= 4 && (bytes[0] & 0xf0) == 0x50 && bytes[1] == 0x2a && bytes[2] == 0x4d && bytes[3] == 0x18) {
+        return Compression::ZSTD;
+    }
+    return Compression::NONE;
+}
+
+inline bool isCompressionSupported(Compression compression) {
+    switch (compression) {
+        case Compression::NONE: return true;
+#ifdef DATAPLATFORM_WITH_ZLIB
+        case Compression::GZIP: return true;
+#endif
+#ifdef DATAPLATFORM_WITH_ZSTD
+        case Compression::ZSTD: return true;
+#endif
+        default: return false;
+    }
+}
+
+// zstd ÿѹޣԿƣ߳޹أ֤ʽȡڴн
+constexpr size_t ZSTD_BATCH_OUTPUT_BLOCKS = 4;
+
+// openDecodedSource Ŀ÷ԼĵǰͽضУ
+// δѹʱΪԤ depth 飻ѹʱԭʼݵԤ
+inline size_t decodedSourceBlocks(Compression compression, size_t depth) {
+    if (compression == Compression::NONE) return depth;
+    return depth + 1 + ZSTD_BATCH_OUTPUT_BLOCKS + std::max<size_t>(depth, 1);
+}
+
+inline Compression detectFileCompression(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw PlatformException("Failed to open file: " + path);
+    }
+    char magic[4];
+    file.read(magic, sizeof(magic));
+    return detectCompression(magic, static_cast<size_t>(file.gcount()));
+}
+
+#ifdef DATAPLATFORM_WITH_ZLIB
+// gzip ֽԴֶ֧ gzip Աβӵļpigzcat ƴӵĽ
+class GzipByteSource : public IByteSource {
+private:
+    std::unique_ptr<IByteSource> inner_;
+    std::vector<char> input_;
+    z_stream stream_;
+    bool inputEof_;
+    bool finished_;
+
+public:
+    explicit GzipByteSource(std::unique_ptr<IByteSource> inner, size_t inputBytes = 1 << 20)
+        : inner_(std::move(inner))
+        , input_(std::max<size_t>(inputBytes, 4096))
+        , inputEof_(false)
+        , finished_(false)
+    {
+        std::memset(&stream_, 0, sizeof(stream_));
+        // 15 + 16: gzip wrapper only
+        if (inflateInit2(&stream_, 15 + 16) != Z_OK) {
+            throw PlatformException("Failed to initialize gzip decoder");
+        }
+    }
+
+    ~GzipByteSource() override {
+        inflateEnd(&stream_);
+    }
+
+    GzipByteSource(const GzipByteSource&) = delete;
+    GzipByteSource& operator=(const GzipByteSource&) = delete;
+
+    size_t read(char* dst, size_t capacity) override {
+        stream_.next_out = reinterpret_cast<Bytef*>(dst);
+        stream_.avail_out = static_cast<uInt>(std::min<size_t>(capacity, UINT_MAX));
+        const uInt requested = stream_.avail_out;
+
+        while (stream_.avail_out > 0 && !finished_) {
+            if (stream_.avail_in == 0) {
+                fillInput();
+                if (stream_.avail_in == 0) {
+                    throw PlatformException("Truncated gzip input");
+                }
+            }
+
+            int rc = inflate(&stream_, Z_NO_FLUSH);
+            if (rc == Z_STREAM_END) {
+                // Another member may follow; anything else ends the stream
+                if (stream_.avail_in == 0) {
+                    fillInput();
+                }
+                if (stream_.avail_in == 0) {
+                    finished_ = true;
+                } else if (inflateReset(&stream_) != Z_OK) {
+                    throw PlatformException("Failed to reset gzip decoder");
+                }
+            } else if (rc != Z_OK) {
+                throw PlatformException(std::string("Corrupted gzip input: ") +
+                                        (stream_.msg ? stream_.msg : "inflate failed"));
+            }
+        }
+        return requested - stream_.avail_out;
+    }
+
+private:
+    void fillInput() {
+        if (inputEof_) return;
+        size_t n = inner_->read(input_.data(), input_.size());
+        if (n == 0) inputEof_ = true;
+        stream_.next_in = reinterpret_cast<Bytef*>(input_.data());
+        stream_.avail_in = static_cast<uInt>(n);
+    }
+};
+#endif
+
+#ifdef DATAPLATFORM_WITH_ZSTD
+// zstd ֽԴ
+// 밴ȡҼ¼ԭʼС֡ͨ executor нѹÿ
+//  ZSTD_BATCH_OUTPUT_BLOCKS С֡δ¼С֡˻ʽѹ
+class ZstdByteSource : public IByteSource {
+private:
+    struct Frame {
+        const char* src;
+        size_t srcSize;
+        size_t dstOffset;
+        size_t dstSize;
+    };
+
+    std::unique_ptr<IByteSource> inner_;
+    IExecutor* executor_;
+    size_t batchBytes_;
+    size_t maxBatchOutput_;
+
+    std::vector<char> input_;
+    size_t inBegin_;
+    size_t inEnd_;
+    bool inputEof_;
+
+    std::vector<char> output_;   // decoded bytes not yet handed out
+    size_t outPos_;
+
+    ZSTD_DStream* stream_;
+    bool streaming_;             // in the middle of a frame decoded incrementally
+
+public:
+    ZstdByteSource(std::unique_ptr<IByteSource> inner, IExecutor* executor, size_t batchBytes)
+        : inner_(std::move(inner))
+        , executor_(executor)
+        , batchBytes_(std::max<size_t>(batchBytes, 64 * 1024))
+        , maxBatchOutput_(batchBytes_ * ZSTD_BATCH_OUTPUT_BLOCKS)
+        , input_(batchBytes_)
+        , inBegin_(0)
+        , inEnd_(0)
+        , inputEof_(false)
+        , outPos_(0)
+        , stream_(ZSTD_createDStream())
+        , streaming_(false)
+    {
+        if (!stream_) {
+            throw PlatformException("Failed to initialize zstd decoder");
+        }
+    }
+
+    ~ZstdByteSource() override {
+        ZSTD_freeDStream(stream_);
+    }
+
+    ZstdByteSource(const ZstdByteSource&) = delete;
+    ZstdByteSource& operator=(const ZstdByteSource&) = delete;
+
+    size_t read(char* dst, size_t capacity) override {
+        size_t copied = 0;
+        while (copied < capacity) {
+            if (outPos_ == output_.size()) {
+                if (!decodeMore()) break;
+                continue;
+            }
+            size_t n = std::min(capacity - copied, output_.size() - outPos_);
+            std::memcpy(dst + copied, output_.data() + outPos_, n);
+            copied += n;
+            outPos_ += n;
+        }
+        return copied;
+    }
+
+private:
+    // Tops the input buffer up to batchBytes_, keeping unconsumed bytes
+    void fillInput() {
+        if (inBegin_ > 0) {
+            std::memmove(input_.data(), input_.data() + inBegin_, inEnd_ - inBegin_);
+            inEnd_ -= inBegin_;
+            inBegin_ = 0;
+        }
+        while (!inputEof_ && inEnd_ < input_.size()) {
+            size_t n = inner_->read(input_.data() + inEnd_, input_.size() - inEnd_);
+            if (n == 0) inputEof_ = true;
+            inEnd_ += n;
+        }
+    }
+
+    // Replaces output_ with the next decoded bytes; returns false at end of input
+    bool decodeMore() {
+        output_.clear();
+        outPos_ = 0;
+        if (streaming_) {
+            return decodeStreaming();
+        }
+
+        fillInput();
+        if (inBegin_ == inEnd_) return false;
+
+        // Collect the complete frames at the front of the batch
+        std::vector<Frame> frames;
+        size_t total = 0;
+        const char* p = input_.data() + inBegin_;
+        const char* end = input_.data() + inEnd_;
+        while (p < end) {
+            size_t frameSize = ZSTD_findFrameCompressedSize(p, static_cast<size_t>(end - p));
+            if (ZSTD_isError(frameSize)) break;   // incomplete in this batch
+            unsigned long long content = ZSTD_getFrameContentSize(p, frameSize);
+            if (content == ZSTD_CONTENTSIZE_UNKNOWN || content == ZSTD_CONTENTSIZE_ERROR) break;
+            if (total + content > maxBatchOutput_) break;
+            frames.push_back({p, frameSize, total, static_cast<size_t>(content)});
+            total += static_cast<size_t>(content);
+            p += frameSize;
+        }
+
+        if (frames.empty()) {
+            ZSTD_DCtx_reset(stream_, ZSTD_reset_session_only);
+            streaming_ = true;
+            return decodeStreaming();
+        }
+
+        output_.resize(total);
+        auto decode = [this, &frames](size_t i) {
+            const Frame& frame = frames[i];
+            size_t n = ZSTD_decompress(output_.data() + frame.dstOffset, frame.dstSize,
+                                       frame.src, frame.srcSize);
+            if (ZSTD_isError(n) || n != frame.dstSize) {
+                throw PlatformException(std::string("Corrupted zstd input: ") +
+                    (ZSTD_isError(n) ? ZSTD_getErrorName(n) : "frame size mismatch"));
+            }
+        };
+        if (frames.size() > 1 && executor_) {
+            executor_->parallelFor(frames.size(), decode);
+        } else {
+            for (size_t i = 0; i < frames.size(); ++i) decode(i);
+        }
+        inBegin_ = static_cast<size_t>(p - input_.data());
+        return true;
+    }
+
+    bool decodeStreaming() {
+        output_.resize(batchBytes_);
+        ZSTD_outBuffer out = {output_.data(), output_.size(), 0};
+        while (out.pos < out.size) {
+            if (inBegin_ == inEnd_) {
+                fillInput();
+                if (inBegin_ == inEnd_) {
+                    throw PlatformException("Truncated zstd input");
+                }
+            }
+            ZSTD_inBuffer in = {input_.data() + inBegin_, inEnd_ - inBegin_, 0};
+            size_t rc = ZSTD_decompressStream(stream_, &out, &in);
+            if (ZSTD_isError(rc)) {
+                throw PlatformException(std::string("Corrupted zstd input: ") + ZSTD_getErrorName(rc));
+            }
+            inBegin_ += in.pos;
+            if (rc == 0) {
+                // Frame finished; the next one may be decoded in parallel again
+                streaming_ = false;
+                break;
+            }
+        }
+        output_.resize(out.pos);
+        return true;
+    }
+};
+#endif
+
+// ļ͸ѹѹڶ߳ϽУ÷Ľص
+// ѹʽδڱʱʱ׳ PlatformException
+inline std::unique_ptr<IByteSource> openDecodedSource(const std::string& path, size_t blockSize,
+                                                      size_t depth, bool preferUring,
+                                                      IExecutor* executor) {
+    const Compression compression = detectFileCompression(path);
+    if (compression == Compression::NONE) {
+        return openSequentialSource(path, blockSize, depth, preferUring);
+    }
+
+    std::unique_ptr<IByteSource> raw = openSequentialSource(path, blockSize, depth, preferUring);
+    std::unique_ptr<IByteSource> decoded;
+    if (compression == Compression::GZIP) {
+#ifdef DATAPLATFORM_WITH_ZLIB
+        decoded.reset(new GzipByteSource(std::move(raw), blockSize));
+#else
+        throw PlatformException("gzip input requires building with DATAPLATFORM_WITH_ZLIB: " + path);
+#endif
+    } else {
+#ifdef DATAPLATFORM_WITH_ZSTD
+        decoded.reset(new ZstdByteSource(std::move(raw), executor, blockSize));
+#else
+        throw PlatformException("zstd input requires building with DATAPLATFORM_WITH_ZSTD: " + path);
+#endif
+    }
+    (void)executor;
+    return std::unique_ptr<IByteSource>(
+        new PrefetchingByteSource(std::move(decoded), blockSize, std::max<size_t>(depth, 1)));
+}
+
+} // namespace DataPlatform
+
+#endif // COMPRESSION_H
\ No newline at end of file
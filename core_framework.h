@@ -3,11 +3,21 @@
 #define CORE_FRAMEWORK_H
 
 #include <string>
+#include <sstream>
+#include <ostream>
+#include <cstdint>
+#include <utility>
 #include <memory>
 #include <vector>
 #include <map>
+#include <algorithm>
 #include <stdexcept>
 #include <functional>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 
 namespace DataPlatform {
 
@@ -23,7 +33,188 @@ public:
         : std::runtime_error(message) {}
 };
 
+// еı񣺰д洢ÿΪ㡢ı
+class ResultTable {
+public:
+    enum class ColumnType {
+        NUMBER,
+        INTEGER,
+        TEXT
+    };
+
+    struct Column {
+        std::string name;
+        ColumnType type;
+        std::vector<double> numbers;
+        std::vector<int64_t> integers;
+        std::vector<std::string> strings;
+    };
+
+private:
+    std::vector<Column> columns_;
+    size_t rowCount_ = 0;
+
+public:
+    ResultTable& addColumn(const std::string& name, std::vector<double> values) {
+        Column& column = appendColumn(name, ColumnType::NUMBER, values.size());
+        column.numbers = std::move(values);
+        return *this;
+    }
+
+    ResultTable& addColumn(const std::string& name, std::vector<int64_t> values) {
+        Column& column = appendColumn(name, ColumnType::INTEGER, values.size());
+        column.integers = std::move(values);
+        return *this;
+    }
+
+    ResultTable& addColumn(const std::string& name, std::vector<std::string> values) {
+        Column& column = appendColumn(name, ColumnType::TEXT, values.size());
+        column.strings = std::move(values);
+        return *this;
+    }
+
+    size_t getRowCount() const { return rowCount_; }
+    size_t getColumnCount() const { return columns_.size(); }
+    const Column& getColumn(size_t index) const { return columns_.at(index); }
+
+    const Column* findColumn(const std::string& name) const {
+        for (const auto& column : columns_) {
+            if (column.name == name) return &column;
+        }
+        return nullptr;
+    }
+
+    const std::vector<double>& getNumbers(const std::string& name) const {
+        return requireColumn(name, ColumnType::NUMBER).numbers;
+    }
+
+    const std::vector<int64_t>& getIntegers(const std::string& name) const {
+        return requireColumn(name, ColumnType::INTEGER).integers;
+    }
+
+    const std::vector<std::string>& getStrings(const std::string& name) const {
+        return requireColumn(name, ColumnType::TEXT).strings;
+    }
+
+    // ͨıʽÿһ"=ֵ" Զŷָ
+    void render(std::ostream& out) const {
+        for (size_t row = 0; row < rowCount_; ++row) {
+            for (size_t i = 0; i < columns_.size(); ++i) {
+                const Column& column = columns_[i];
+                out << (i > 0 ? ", " : "") << column.name << "=";
+                switch (column.type) {
+                    case ColumnType::NUMBER:  out << column.numbers[row]; break;
+                    case ColumnType::INTEGER: out << column.integers[row]; break;
+                    case ColumnType::TEXT:    out << column.strings[row]; break;
+                }
+            }
+            out << "\n";
+        }
+    }
+
+private:
+    Column& appendColumn(const std::string& name, ColumnType type, size_t rows) {
+        if (!columns_.empty() && rows != rowCount_) {
+            throw PlatformException("Result column length mismatch: " + name);
+        }
+        rowCount_ = rows;
+        columns_.push_back(Column{name, type, {}, {}, {}});
+        return columns_.back();
+    }
+
+    const Column& requireColumn(const std::string& name, ColumnType type) const {
+        const Column* column = findColumn(name);
+        if (!column || column->type != type) {
+            throw PlatformException("Result column not found: " + name);
+        }
+        return *column;
+    }
+};
+
+// ṹĽݣııֶΡֵͱ񣬰д˳򱣴档
+// һƶ룬ıʽֻҪʱ
+class ResultPayload {
+private:
+    template<typename T>
+    using Fields = std::vector<std::pair<std::string, T>>;
+
+    Fields<double> scalars_;
+    Fields<std::string> texts_;
+    Fields<std::vector<double>> arrays_;
+    Fields<ResultTable> tables_;
+
+public:
+    void setScalar(const std::string& name, double value) { assign(scalars_, name, value); }
+    void setText(const std::string& name, std::string value) { assign(texts_, name, std::move(value)); }
+    void setArray(const std::string& name, std::vector<double> values) { assign(arrays_, name, std::move(values)); }
+    void setTable(const std::string& name, ResultTable table) { assign(tables_, name, std::move(table)); }
+
+    bool hasScalar(const std::string& name) const { return find(scalars_, name) != nullptr; }
+    bool hasText(const std::string& name) const { return find(texts_, name) != nullptr; }
+    bool hasArray(const std::string& name) const { return find(arrays_, name) != nullptr; }
+    bool hasTable(const std::string& name) const { return find(tables_, name) != nullptr; }
+
+    double getScalar(const std::string& name) const { return require(scalars_, name); }
+    const std::string& getText(const std::string& name) const { return require(texts_, name); }
+    const std::vector<double>& getArray(const std::string& name) const { return require(arrays_, name); }
+    const ResultTable& getTable(const std::string& name) const { return require(tables_, name); }
+
+    const Fields<double>& getScalars() const { return scalars_; }
+    const Fields<std::string>& getTexts() const { return texts_; }
+    const Fields<std::vector<double>>& getArrays() const { return arrays_; }
+    const Fields<ResultTable>& getTables() const { return tables_; }
+
+    bool empty() const {
+        return scalars_.empty() && texts_.empty() && arrays_.empty() && tables_.empty();
+    }
+
+    // ͨıʽûṩרȾĽ
+    void render(std::ostream& out) const {
+        for (const auto& field : texts_) out << field.first << ": " << field.second << "\n";
+        for (const auto& field : scalars_) out << field.first << ": " << field.second << "\n";
+        for (const auto& field : arrays_) {
+            out << field.first << ":";
+            for (double value : field.second) out << " " << value;
+            out << "\n";
+        }
+        for (const auto& field : tables_) {
+            out << field.first << ":\n";
+            field.second.render(out);
+        }
+    }
+
+private:
+    template<typename T, typename V>
+    static void assign(Fields<T>& fields, const std::string& name, V&& value) {
+        for (auto& field : fields) {
+            if (field.first == name) {
+                field.second = std::forward<V>(value);
+                return;
+            }
+        }
+        fields.emplace_back(name, std::forward<V>(value));
+    }
+
+    template<typename T>
+    static const T* find(const Fields<T>& fields, const std::string& name) {
+        for (const auto& field : fields) {
+            if (field.first == name) return &field.second;
+        }
+        return nullptr;
+    }
+
+    template<typename T>
+    static const T& require(const Fields<T>& fields, const std::string& name) {
+        const T* value = find(fields, name);
+        if (!value) {
+            throw PlatformException("Result field not found: " + name);
+        }
+        return *value;
+    }
+};
+
 // Result class to store processing results
+// ֻƶݿ MBҪʱʽ clone()
 class Result {
 public:
     enum class Status {
@@ -33,24 +224,171 @@ public:
         PROCESSING
     };
 
+    // Writes the text form of a payload
+    using Renderer = std::function<void(const ResultPayload&, std::ostream&)>;
+
 private:
     Status status_;
     std::string message_;
     std::string data_;
     std::string timestamp_;
+    ResultPayload payload_;
+    Renderer renderer_;
+    // Text rendered from the payload on first use, shared by every later reader
+    mutable std::shared_ptr<const std::string> rendered_;
 
 public:
     Result() : status_(Status::PENDING) {}
 
+    Result(Result&&) = default;
+    Result& operator=(Result&&) = default;
+
+    Result clone() const { return Result(*this); }
+
     void setStatus(Status status) { status_ = status; }
     void setMessage(const std::string& message) { message_ = message; }
-    void setData(const std::string& data) { data_ = data; }
+    void setData(std::string data) {
+        data_ = std::move(data);
+        rendered_.reset();
+    }
     void setTimestamp(const std::string& timestamp) { timestamp_ = timestamp; }
 
+    // ṹgetData() һεʱ rendererȱʡΪͨøʽı
+    void setPayload(ResultPayload payload, Renderer renderer = nullptr) {
+        payload_ = std::move(payload);
+        renderer_ = std::move(renderer);
+        rendered_.reset();
+    }
+
     Status getStatus() const { return status_; }
-    std::string getMessage() const { return message_; }
-    std::string getData() const { return data_; }
-    std::string getTimestamp() const { return timestamp_; }
+    const std::string& getMessage() const { return message_; }
+    const std::string& getTimestamp() const { return timestamp_; }
+    const ResultPayload& getPayload() const { return payload_; }
+
+    // Text set explicitly wins; otherwise the payload is rendered once and the
+    // cached text is returned. Concurrent first readers may each render, but all
+    // of them get the string that was published first
+    const std::string& getData() const {
+        if (!data_.empty() || payload_.empty()) return data_;
+        std::shared_ptr<const std::string> rendered = std::atomic_load(&rendered_);
+        if (!rendered) {
+            std::ostringstream out;
+            writeData(out);
+            auto text = std::make_shared<const std::string>(out.str());
+            if (std::atomic_compare_exchange_strong(&rendered_, &rendered, text)) {
+                rendered = std::move(text);
+            }
+        }
+        return *rendered;
+    }
+
+    // Streams the text form without building an intermediate string
+    void writeData(std::ostream& out) const {
+        if (!data_.empty() || payload_.empty()) {
+            out << data_;
+        } else if (renderer_) {
+            renderer_(payload_, out);
+        } else {
+            payload_.render(out);
+        }
+    }
+
+private:
+    // clone() may run while other threads read the shared original through getData()
+    Result(const Result& other)
+        : status_(other.status_), message_(other.message_), data_(other.data_),
+          timestamp_(other.timestamp_), payload_(other.payload_), renderer_(other.renderer_),
+          rendered_(std::atomic_load(&other.rendered_)) {}
+    Result& operator=(const Result&) = delete;
+};
+
+// Interface for parallel executors
+class IExecutor {
+public:
+    virtual ~IExecutor() = default;
+
+    // Number of jobs that can run at the same time
+    virtual size_t getConcurrency() const = 0;
+
+    // Runs job(0) ... job(count - 1) and blocks until all of them returned.
+    // The first exception thrown by a job is rethrown to the caller.
+    virtual void parallelFor(size_t count, const std::function<void(size_t)>& job) = 0;
+};
+
+// A batch of parallelFor jobs shared by the caller and helper threads.
+// Every participant claims indices until none are left, so the batch
+// completes even if no helper ever gets scheduled.
+class ParallelBatch {
+private:
+    size_t count_;
+    std::function<void(size_t)> job_;
+    std::atomic<size_t> next_;
+    std::atomic<size_t> done_;
+    std::exception_ptr error_;
+    std::mutex mutex_;
+    std::condition_variable finished_;
+
+public:
+    ParallelBatch(size_t count, const std::function<void(size_t)>& job)
+        : count_(count), job_(job), next_(0), done_(0) {}
+
+    void run() {
+        size_t index;
+        while ((index = next_.fetch_add(1)) < count_) {
+            try {
+                job_(index);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) error_ = std::current_exception();
+            }
+            if (done_.fetch_add(1) + 1 == count_) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                finished_.notify_all();
+            }
+        }
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        finished_.wait(lock, [this] { return done_.load() == count_; });
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+};
+
+// Executor that starts short-lived threads for each parallelFor call.
+// Used when no TaskManager is attached.
+class ThreadExecutor : public IExecutor {
+private:
+    size_t concurrency_;
+
+public:
+    explicit ThreadExecutor(size_t concurrency = std::thread::hardware_concurrency())
+        : concurrency_(concurrency > 0 ? concurrency : 1) {}
+
+    size_t getConcurrency() const override { return concurrency_; }
+
+    void parallelFor(size_t count, const std::function<void(size_t)>& job) override {
+        if (count == 0) return;
+        ParallelBatch batch(count, job);
+
+        std::vector<std::thread> helpers;
+        size_t helperCount = std::min(count, concurrency_) - 1;
+        for (size_t i = 0; i < helperCount; ++i) {
+            helpers.emplace_back([&batch] { batch.run(); });
+        }
+        batch.run();
+        for (auto& thread : helpers) {
+            thread.join();
+        }
+        batch.wait();
+    }
+
+    static ThreadExecutor& getDefault() {
+        static ThreadExecutor executor;
+        return executor;
+    }
 };
 
 // Interface for Dataset
@@ -3,14 +3,26 @@
 #define DATA_MANAGEMENT_H
 
 #include "core_framework.h"
+#include "file_io.h"
+#include "compression.h"
+#include "numeric_kernels.h"
+#include "text_kernels.h"
+#include "table_kernels.h"
 #include <fstream>
 #include <sstream>
 #include <vector>
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <memory>
 #include <algorithm>
 #include <numeric>
 #include <cmath>
+#include <limits>
+#include <iterator>
+#include <mutex>
+#include <atomic>
+#include <random>
 
 namespace DataPlatform {
 
@@ -20,24 +32,203 @@ enum class DataType {
     TEXT,
     CATEGORICAL,
     DATETIME,
+    TABLE,          // бÿԼ
+    MATRIX,         // ֵ󣬰ȴ洢
     UNDEFINED
 };
 
+// ݴѡ
+struct ProcessingOptions {
+    bool parallel;          // бֿ߽飬̼߳ͳ
+    size_t minChunkBytes;   // ÿзֿСֽ
+    size_t minChunkLines;   // дƵͳʱÿƬ
+    bool compactText;       // ıڵУ LineBuffer
+    size_t memoryBudget;    // ʽȡͳѡȿʹõĻֽ
+    size_t readAhead;       // ʽȡʱԤĿ
+    bool asyncIO;           // 첽ȡ߶߽io_uringʱ˻Ԥ̣߳
+
+    ProcessingOptions()
+        : parallel(false)
+        , minChunkBytes(4 << 20)
+        , minChunkLines(16384)
+        , compactText(false)
+        , memoryBudget(64 << 20)
+        , readAhead(2)
+        , asyncIO(false) {}
+};
+
+// Ԥ׶
+struct PreprocessStage {
+    enum class Kind {
+        DROP_NAN,     // ɾ NaN
+        CLIP,         // ضϵ [first, second]
+        LOG,          // Ȼ
+        ZSCORE,       // (x - mean) / std_dev
+        MIN_MAX,      // ŵ [first, second]
+        IQR_FILTER    // ɾ [Q1 - first * IQR, Q3 + first * IQR] ֵ֮
+    };
+
+    Kind kind;
+    double first;
+    double second;
+};
+
+// ϵԤˮ
+//  PreprocessPipeline().dropNaN().clip(0, 100).zScore()
+// ַͨ "dropna,clip:0:100,zscore" 
+class PreprocessPipeline {
+private:
+    std::vector<PreprocessStage> stages_;
+
+public:
+    PreprocessPipeline& dropNaN() { return add(PreprocessStage::Kind::DROP_NAN); }
+    PreprocessPipeline& clip(double lower, double upper) {
+        return add(PreprocessStage::Kind::CLIP, lower, upper);
+    }
+    PreprocessPipeline& log() { return add(PreprocessStage::Kind::LOG); }
+    PreprocessPipeline& zScore() { return add(PreprocessStage::Kind::ZSCORE); }
+    PreprocessPipeline& minMax(double low = 0.0, double high = 1.0) {
+        return add(PreprocessStage::Kind::MIN_MAX, low, high);
+    }
+    PreprocessPipeline& removeOutliersIQR(double factor = 1.5) {
+        return add(PreprocessStage::Kind::IQR_FILTER, factor);
+    }
+
+    const std::vector<PreprocessStage>& getStages() const { return stages_; }
+    bool empty() const { return stages_.empty(); }
+
+    // ŷָĽ׶б׶βðŷָ
+    // dropna | clip:<lower>:<upper> | log | zscore | minmax[:<low>:<high>] | iqr[:<factor>]
+    static PreprocessPipeline parse(const std::string& spec) {
+        PreprocessPipeline pipeline;
+        std::istringstream stages(spec);
+        std::string stage;
+        while (std::getline(stages, stage, ',')) {
+            std::vector<std::string> parts;
+            std::istringstream fields(stage);
+            std::string field;
+            while (std::getline(fields, field, ':')) {
+                parts.push_back(field);
+            }
+            if (parts.empty() || parts[0].empty()) continue;
+
+            auto arg = [&](size_t index, double fallback) {
+                if (index >= parts.size()) return fallback;
+                double value;
+                if (!parseDoubleField(parts[index], value)) {
+                    throw PlatformException("Invalid preprocessing argument: " + stage);
+                }
+                return value;
+            };
+
+            const std::string& name = parts[0];
+            if (name == "dropna") pipeline.dropNaN();
+            else if (name == "log") pipeline.log();
+            else if (name == "zscore") pipeline.zScore();
+            else if (name == "minmax") pipeline.minMax(arg(1, 0.0), arg(2, 1.0));
+            else if (name == "iqr") pipeline.removeOutliersIQR(arg(1, 1.5));
+            else if (name == "clip") {
+                if (parts.size() != 3) {
+                    throw PlatformException("clip requires lower and upper bounds: " + stage);
+                }
+                const double lower = arg(1, 0.0);
+                const double upper = arg(2, 0.0);
+                if (!(lower <= upper)) {
+                    throw PlatformException("clip lower bound exceeds upper bound: " + stage);
+                }
+                pipeline.clip(lower, upper);
+            }
+            else {
+                throw PlatformException("Unknown preprocessing stage: " + name);
+            }
+        }
+        return pipeline;
+    }
+
+private:
+    PreprocessPipeline& add(PreprocessStage::Kind kind, double first = 0.0, double second = 0.0) {
+        stages_.push_back({kind, first, second});
+        return *this;
+    }
+};
+
+// дʱƵݻʱֻͬһݣдǰԱ类ã
+// Ÿһݣ滻reset򲻸ƾݡ
+//  clone() Ķ̬ͣ Columnͨ clone() ƣʹøƹ캯
+template<typename T>
+class CopyOnWrite {
+private:
+    std::shared_ptr<T> value_;
+
+public:
+    CopyOnWrite() : value_(std::make_shared<T>()) {}
+    explicit CopyOnWrite(T value) : value_(std::make_shared<T>(std::move(value))) {}
+    explicit CopyOnWrite(std::shared_ptr<T> value) : value_(std::move(value)) {}
+
+    const T& operator*() const { return *value_; }
+    const T* operator->() const { return value_.get(); }
+
+    T& write() {
+        if (value_.use_count() > 1) {
+            value_ = copy(*value_, 0);
+        } else {
+            // use_count() is a relaxed load; the fence orders our writes after the
+            // reads a snapshot made before it released the buffer on another thread
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *value_;
+    }
+
+    void reset(T value = T()) { value_ = std::make_shared<T>(std::move(value)); }
+
+    bool isShared() const { return value_.use_count() > 1; }
+
+private:
+    template<typename U>
+    static auto copy(const U& value, int) -> decltype(std::shared_ptr<T>(value.clone())) {
+        return std::shared_ptr<T>(value.clone());
+    }
+
+    template<typename U>
+    static std::shared_ptr<T> copy(const U& value, long) {
+        return std::make_shared<T>(value);
+    }
+};
+
 // ݼ
+// ݱ CopyOnWrite Уsnapshot() õЩֻ汾
+// ޸ݵĳԱڿͷ beginMutation() snapshot() Ⲣʹ汾żһ
 class BaseDataset : public IDataset {
 protected:
     std::string name_;
     std::string description_;
     DataType type_;
     bool isPreprocessed_;
-    std::map<std::string, std::string> metadata_;
+    mutable std::map<std::string, std::string> metadata_;
+    ProcessingOptions options_;
+    IExecutor* executor_;   // Ȩָͨ TaskManager
+    uint64_t version_;
+    mutable std::recursive_mutex versionMutex_;
 
 public:
     BaseDataset(const std::string& name, DataType type)
-        : name_(name), type_(type), isPreprocessed_(false) {}
+        : name_(name), type_(type), isPreprocessed_(false), executor_(nullptr), version_(0) {}
 
     virtual ~BaseDataset() = default;
 
+    // ǰ汾Ŀգһݻݼ󣬲ݡ
+    // ֮Աݼ޸ֻ°汾ձֲ䣻޸ĿͬӰ챾ݼ
+    // ֿ֧յݼͷ nullptr
+    std::shared_ptr<BaseDataset> snapshot() const {
+        std::lock_guard<std::recursive_mutex> lock(versionMutex_);
+        return cloneVersion();
+    }
+
+    uint64_t getVersion() const {
+        std::lock_guard<std::recursive_mutex> lock(versionMutex_);
+        return version_;
+    }
+
     // IDataset interface implementation
     std::string getType() const override {
         return toString(type_);
@@ -52,189 +243,555 @@ public:
 
     // Metadata management
     void setMetadata(const std::string& key, const std::string& value) {
+        std::lock_guard<std::recursive_mutex> lock(versionMutex_);
         metadata_[key] = value;
     }
 
     std::string getMetadata(const std::string& key) const {
+        std::lock_guard<std::recursive_mutex> lock(versionMutex_);
+        refreshMetadata();
         auto it = metadata_.find(key);
         return (it != metadata_.end()) ? it->second : "";
     }
 
+    // ִԤˮߣ֧ˮߵݼͷ false
+    virtual bool applyPipeline(const PreprocessPipeline& pipeline) {
+        (void)pipeline;
+        return false;
+    }
+
+    // Parallel processing
+    void setProcessingOptions(const ProcessingOptions& options) { options_ = options; }
+    const ProcessingOptions& getProcessingOptions() const { return options_; }
+    void setExecutor(IExecutor* executor) { executor_ = executor; }
+    IExecutor& getExecutor() const { return executor(); }
+
 protected:
+    // Copies everything except the lock; the data buffers stay shared
+    BaseDataset(const BaseDataset& other)
+        : IDataset(other)
+        , name_(other.name_)
+        , description_(other.description_)
+        , type_(other.type_)
+        , isPreprocessed_(other.isPreprocessed_)
+        , metadata_(other.metadata_)
+        , options_(other.options_)
+        , executor_(other.executor_)
+        , version_(other.version_) {}
+
+    // Subclasses return a copy of themselves; called under the version lock
+    virtual std::shared_ptr<BaseDataset> cloneVersion() const { return nullptr; }
+
+    std::unique_lock<std::recursive_mutex> beginMutation() {
+        std::unique_lock<std::recursive_mutex> lock(versionMutex_);
+        ++version_;
+        return lock;
+    }
+
+    // Lets subclasses format derived metadata lazily, right before it is read
+    virtual void refreshMetadata() const {}
+
+    IExecutor& executor() const {
+        return executor_ ? *executor_ : ThreadExecutor::getDefault();
+    }
+
+    // Splits a loaded buffer into chunks of whole lines for parallel parsing
+    std::vector<ByteRange> planChunks(const char* first, const char* last) const {
+        if (!options_.parallel) {
+            return {ByteRange{first, last}};
+        }
+        return splitAtLineBoundaries(first, last,
+            executor().getConcurrency() * 4, options_.minChunkBytes);
+    }
+
+    // Block size for asyncIO loads: big enough to still split into parallel chunks
+    size_t getLoadChunkBytes() const {
+        return options_.parallel ? options_.minChunkBytes * executor().getConcurrency()
+                                 : options_.minChunkBytes;
+    }
+
+    // λصļÿֻеֽڿ飬Ķȡѹصص
+    void forEachLineChunk(const std::string& path, size_t chunkBytes,
+                          const std::function<void(const char*, const char*)>& consumer) const {
+        LineChunkReader reader(
+            openDecodedSource(path, chunkBytes, options_.readAhead, options_.asyncIO, &executor()),
+            chunkBytes);
+        ByteRange chunk;
+        while (reader.next(chunk)) {
+            consumer(chunk.first, chunk.last);
+        }
+    }
+
     static std::string toString(DataType type) {
         switch (type) {
             case DataType::NUMERIC: return "NUMERIC";
             case DataType::TEXT: return "TEXT";
             case DataType::CATEGORICAL: return "CATEGORICAL";
             case DataType::DATETIME: return "DATETIME";
+            case DataType::TABLE: return "TABLE";
+            case DataType::MATRIX: return "MATRIX";
             default: return "UNDEFINED";
         }
     }
 };
 
+// ֵݼƸʽͷȫֶΪСˣ
+// magic[8] | version u32 | headerSize u32 | count u64 | min | max | mean | std_dev
+// | payloadChecksum u64 | headerChecksum u64 count  double
+struct NumericBinaryHeader {
+    static constexpr size_t SIZE = 72;
+    static constexpr uint32_t VERSION = 1;
+    static constexpr char MAGIC[8] = {'D', 'P', 'N', 'U', 'M', 'B', 'I', 'N'};
+
+    uint64_t count = 0;
+    double minValue = 0.0;
+    double maxValue = 0.0;
+    double mean = 0.0;
+    double stdDev = 0.0;
+    uint64_t payloadChecksum = 0;
+
+    static bool matches(const char* data, size_t size) {
+        return size >= sizeof(MAGIC) && std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+    }
+
+    std::vector<unsigned char> encode() const {
+        std::vector<unsigned char> out(SIZE);
+        std::memcpy(out.data(), MAGIC, sizeof(MAGIC));
+        storeLE32(out.data() + 8, VERSION);
+        storeLE32(out.data() + 12, static_cast<uint32_t>(SIZE));
+        storeLE64(out.data() + 16, count);
+        storeLE64(out.data() + 24, doubleBits(minValue));
+        storeLE64(out.data() + 32, doubleBits(maxValue));
+        storeLE64(out.data() + 40, doubleBits(mean));
+        storeLE64(out.data() + 48, doubleBits(stdDev));
+        storeLE64(out.data() + 56, payloadChecksum);
+        storeLE64(out.data() + 64, checksum64(out.data(), 64));
+        return out;
+    }
+
+    bool decode(const char* data, size_t size) {
+        if (size < SIZE || !matches(data, size)) return false;
+        const unsigned char* in = reinterpret_cast<const unsigned char*>(data);
+        if (loadLE32(in + 8) != VERSION || loadLE32(in + 12) != SIZE) return false;
+        if (loadLE64(in + 64) != checksum64(in, 64)) return false;
+
+        count = loadLE64(in + 16);
+        minValue = bitsToDouble(loadLE64(in + 24));
+        maxValue = bitsToDouble(loadLE64(in + 32));
+        mean = bitsToDouble(loadLE64(in + 40));
+        stdDev = bitsToDouble(loadLE64(in + 48));
+        payloadChecksum = loadLE64(in + 56);
+        return count <= (size - SIZE) / sizeof(double);
+    }
+};
+
 // ֵݼʵ
 class NumericDataset : public BaseDataset {
 private:
-    std::vector<double> data_;
+    CopyOnWrite<std::vector<double>> data_;
     double min_value_;
     double max_value_;
     double mean_;
     double std_dev_;
+    StatisticsAccumulator stats_;   // ɺϲͳ״̬֧׷
+    size_t skippedLines_;
+    mutable bool statsMetadataDirty_;
 
 public:
-    NumericDataset() : BaseDataset("NumericDataset", DataType::NUMERIC) {}
+    NumericDataset()
+        : BaseDataset("NumericDataset", DataType::NUMERIC)
+        , min_value_(0.0), max_value_(0.0), mean_(0.0), std_dev_(0.0)
+        , skippedLines_(0), statsMetadataDirty_(false) {}
 
     bool load(const std::string& source) override {
-        std::ifstream file(source);
+        auto lock = beginMutation();
+        data_.reset();
+        skippedLines_ = 0;
+        // Compressed input is always text and is decoded block by block
+        const bool compressed = detectFileCompression(source) != Compression::NONE;
+        if (compressed || (options_.asyncIO && !hasBinaryHeader(source))) {
+            // Parse every block as soon as it arrives while the next ones are read
+            forEachLineChunk(source, getLoadChunkBytes(), [this](const char* first, const char* last) {
+                parseText(first, last);
+            });
+            setMetadata("format", "text");
+            calculateStatistics();
+            setMetadata("skipped_lines", std::to_string(skippedLines_));
+            return !data_->empty();
+        }
+
+        MappedFile file(source);
+        if (NumericBinaryHeader::matches(file.data(), file.size())) {
+            // Statistics come from the header, no need to rescan the data
+            readBinary(file, source);
+            setMetadata("format", "binary");
+        } else {
+            parseText(file.begin(), file.end());
+            setMetadata("format", "text");
+            calculateStatistics();
+        }
+        setMetadata("skipped_lines", std::to_string(skippedLines_));
+
+        return !data_->empty();
+    }
+
+    // ԶƸʽ棬load() Զʶøʽ
+    bool save(const std::string& destination) const {
+        std::ofstream file(destination, std::ios::binary | std::ios::trunc);
         if (!file.is_open()) {
-            throw PlatformException("Failed to open file: " + source);
+            throw PlatformException("Failed to open file: " + destination);
         }
 
-        data_.clear();
-        std::string line;
-        while (std::getline(file, line)) {
-            try {
-                double value = std::stod(line);
-                data_.push_back(value);
-            } catch (const std::exception& e) {
-                // Skip invalid entries
-                continue;
+        NumericBinaryHeader header;
+        header.count = data_->size();
+        header.minValue = min_value_;
+        header.maxValue = max_value_;
+        header.mean = mean_;
+        header.stdDev = std_dev_;
+
+        const size_t payloadBytes = data_->size() * sizeof(double);
+        if (isLittleEndianHost()) {
+            header.payloadChecksum = checksum64(data_->data(), payloadBytes);
+            auto encoded = header.encode();
+            file.write(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+            file.write(reinterpret_cast<const char*>(data_->data()), payloadBytes);
+        } else {
+            std::vector<unsigned char> payload(payloadBytes);
+            for (size_t i = 0; i < data_->size(); ++i) {
+                storeLE64(payload.data() + i * sizeof(double), doubleBits((*data_)[i]));
             }
+            header.payloadChecksum = checksum64(payload.data(), payload.size());
+            auto encoded = header.encode();
+            file.write(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+            file.write(reinterpret_cast<const char*>(payload.data()), payload.size());
         }
 
-        calculateStatistics();
-        return !data_.empty();
+        if (!file) {
+            throw PlatformException("Failed to write file: " + destination);
+        }
+        return true;
     }
 
     bool validate() const override {
-        return !data_.empty();
+        return !data_->empty();
     }
 
     bool preprocess() override {
-        if (data_.empty()) return false;
-
         // Remove outliers using IQR method
-        std::vector<double> sorted_data = data_;
-        std::sort(sorted_data.begin(), sorted_data.end());
-
-        size_t n = sorted_data.size();
-        double q1 = sorted_data[n / 4];
-        double q3 = sorted_data[3 * n / 4];
-        double iqr = q3 - q1;
-        double lower_bound = q1 - 1.5 * iqr;
-        double upper_bound = q3 + 1.5 * iqr;
-
-        data_.erase(
-            std::remove_if(data_.begin(), data_.end(),
-                [lower_bound, upper_bound](double x) {
-                    return x < lower_bound || x > upper_bound;
-                }),
-            data_.end()
-        );
+        return applyPipeline(PreprocessPipeline().removeOutliersIQR());
+    }
 
-        calculateStatistics();
+    // ڵԪؽ׶κϲΪһαz-scoremin-max  IQR Ҫһ
+    // ͳλǰ֮ǰۻĽ׶ִеתΪԪز
+    bool applyPipeline(const PreprocessPipeline& pipeline) override {
+        auto lock = beginMutation();
+        if (data_->empty()) return false;
+
+        std::vector<ElementOp> pending;
+        auto flush = [this, &pending]() {
+            if (pending.empty()) return;
+            // The fused pass also yields the statistics of its output
+            stats_ = applyElementwise(data_.write(), pending);
+            pending.clear();
+        };
+
+        for (const auto& stage : pipeline.getStages()) {
+            switch (stage.kind) {
+                case PreprocessStage::Kind::DROP_NAN:
+                    pending.push_back({ElementOp::Kind::DROP_NAN, 0.0, 0.0});
+                    break;
+                case PreprocessStage::Kind::CLIP:
+                    pending.push_back({ElementOp::Kind::CLIP, stage.first, stage.second});
+                    break;
+                case PreprocessStage::Kind::LOG:
+                    pending.push_back({ElementOp::Kind::LOG, 0.0, 0.0});
+                    break;
+                case PreprocessStage::Kind::ZSCORE: {
+                    flush();
+                    double sd = stats_.stdDev();
+                    double scale = sd > 0.0 ? 1.0 / sd : 0.0;
+                    pending.push_back({ElementOp::Kind::AFFINE, scale, -stats_.mean * scale});
+                    break;
+                }
+                case PreprocessStage::Kind::MIN_MAX: {
+                    flush();
+                    double range = stats_.maxValue - stats_.minValue;
+                    double scale = range > 0.0 ? (stage.second - stage.first) / range : 0.0;
+                    pending.push_back({ElementOp::Kind::AFFINE, scale,
+                                       stage.first - stats_.minValue * scale});
+                    break;
+                }
+                case PreprocessStage::Kind::IQR_FILTER: {
+                    flush();
+                    // Quartiles by selection over the non-NaN values, no full sort
+                    size_t n = getOrderedCount();
+                    if (n == 0) break;
+                    std::vector<double> quartiles = getOrderStatistics({n / 4, 3 * n / 4});
+                    double iqr = quartiles[1] - quartiles[0];
+                    pending.push_back({ElementOp::Kind::KEEP_RANGE,
+                                       quartiles[0] - stage.first * iqr,
+                                       quartiles[1] + stage.first * iqr});
+                    break;
+                }
+            }
+        }
+        flush();
+
+        publishStatistics();
         isPreprocessed_ = true;
         return true;
     }
 
     size_t getSize() const override {
-        return data_.size();
+        return data_->size();
     }
 
     bool isEmpty() const override {
-        return data_.empty();
+        return data_->empty();
     }
 
     void clear() override {
-        data_.clear();
+        auto lock = beginMutation();
+        data_.reset();
+        skippedLines_ = 0;
         calculateStatistics();
     }
 
+    // ׷һݣͳ£ȫ
+    // values ָݼԼݣ append(getData())
+    void append(const double* values, size_t count) {
+        if (count == 0) return;
+        auto lock = beginMutation();
+        // Growing data_ may reallocate the buffer values points into
+        std::vector<double> copy;
+        const std::vector<double>& current = *data_;
+        const std::less<const double*> before;
+        if (!before(values, current.data()) && before(values, current.data() + current.size())) {
+            copy.assign(values, values + count);
+            values = copy.data();
+        }
+        const StatisticsAccumulator batch = computeStatistics(values, count);
+        std::vector<double>& data = data_.write();
+        data.insert(data.end(), values, values + count);
+        stats_.merge(batch);
+        publishStatistics();
+    }
+
+    void append(const std::vector<double>& values) {
+        append(values.data(), values.size());
+    }
+
     // Numeric-specific methods
-    const std::vector<double>& getData() const { return data_; }
+    const std::vector<double>& getData() const { return *data_; }
     double getMinValue() const { return min_value_; }
     double getMaxValue() const { return max_value_; }
     double getMean() const { return mean_; }
     double getStdDev() const { return std_dev_; }
+    size_t getSkippedLines() const { return skippedLines_; }
+
+    // ֵĸ NaN ֵ
+    size_t getOrderedCount() const {
+        return data_->size() - static_cast<size_t>(
+            std::count_if(data_->begin(), data_->end(), [](double x) { return std::isnan(x); }));
+    }
+
+    // ͳ0 ȣNaN С getOrderedCount()
+    // ݳ memoryBudget ʱ data_Ϊԭ϶ɨֱͼѡ
+    std::vector<double> getOrderStatistics(const std::vector<size_t>& ranks) const {
+        auto scan = [this](const std::function<void(const double*, size_t)>& consumer) {
+            consumer(data_->data(), data_->size());
+        };
+        return selectOrderStatisticsBounded(scan, data_->size(), ranks, stats_.minValue, stats_.maxValue,
+                                            options_.memoryBudget / sizeof(double));
+    }
+
+protected:
+    std::shared_ptr<BaseDataset> cloneVersion() const override {
+        return std::make_shared<NumericDataset>(*this);
+    }
 
 private:
-    void calculateStatistics() {
-        if (data_.empty()) {
-            min_value_ = max_value_ = mean_ = std_dev_ = 0.0;
+    // Appends the values parsed from [first, last) to data_
+    void parseText(const char* first, const char* last) {
+        std::vector<double>& data = data_.write();
+        auto chunks = planChunks(first, last);
+        if (chunks.size() == 1) {
+            if (data.empty()) {
+                data.reserve(countLines(first, last));
+            }
+
+            // Invalid entries are skipped and counted
+            skippedLines_ += parseNumericLines(first, last, data);
             return;
         }
 
-        min_value_ = *std::min_element(data_.begin(), data_.end());
-        max_value_ = *std::max_element(data_.begin(), data_.end());
+        // Parse every chunk on its own thread, then join them in order
+        std::vector<std::vector<double>> parts(chunks.size());
+        std::vector<size_t> skipped(chunks.size(), 0);
+        executor().parallelFor(chunks.size(), [&](size_t i) {
+            parts[i].reserve(countLines(chunks[i].first, chunks[i].last));
+            skipped[i] = parseNumericLines(chunks[i].first, chunks[i].last, parts[i]);
+        });
+
+        std::vector<size_t> offsets(parts.size() + 1, data.size());
+        for (size_t i = 0; i < parts.size(); ++i) {
+            offsets[i + 1] = offsets[i] + parts[i].size();
+        }
+        data.resize(offsets.back());
+        executor().parallelFor(parts.size(), [&](size_t i) {
+            std::copy(parts[i].begin(), parts[i].end(), data.begin() + offsets[i]);
+        });
+        skippedLines_ += std::accumulate(skipped.begin(), skipped.end(), size_t(0));
+    }
+
+    static bool hasBinaryHeader(const std::string& source) {
+        std::ifstream file(source, std::ios::binary);
+        if (!file.is_open()) {
+            throw PlatformException("Failed to open file: " + source);
+        }
+        char magic[NumericBinaryHeader::SIZE];
+        file.read(magic, sizeof(magic));
+        return NumericBinaryHeader::matches(magic, static_cast<size_t>(file.gcount()));
+    }
+
+    void readBinary(const MappedFile& file, const std::string& source) {
+        NumericBinaryHeader header;
+        if (!header.decode(file.data(), file.size())) {
+            throw PlatformException("Corrupted binary dataset header: " + source);
+        }
 
-        // Calculate mean
-        mean_ = std::accumulate(data_.begin(), data_.end(), 0.0) / data_.size();
+        const unsigned char* payload =
+            reinterpret_cast<const unsigned char*>(file.data()) + NumericBinaryHeader::SIZE;
+        const size_t payloadBytes = header.count * sizeof(double);
+        if (file.size() - NumericBinaryHeader::SIZE != payloadBytes) {
+            throw PlatformException("Truncated binary dataset: " + source);
+        }
+        if (checksum64(payload, payloadBytes) != header.payloadChecksum) {
+            throw PlatformException("Checksum mismatch in binary dataset: " + source);
+        }
 
-        // Calculate standard deviation
-        double sum_sq = std::accumulate(data_.begin(), data_.end(), 0.0,
-            [this](double acc, double val) {
-                double diff = val - mean_;
-                return acc + diff * diff;
-            });
-        std_dev_ = std::sqrt(sum_sq / data_.size());
+        std::vector<double>& data = data_.write();
+        data.resize(header.count);
+        if (isLittleEndianHost()) {
+            std::memcpy(data.data(), payload, payloadBytes);
+        } else {
+            for (size_t i = 0; i < data.size(); ++i) {
+                data[i] = bitsToDouble(loadLE64(payload + i * sizeof(double)));
+            }
+        }
 
-        // Update metadata
-        setMetadata("min", std::to_string(min_value_));
-        setMetadata("max", std::to_string(max_value_));
-        setMetadata("mean", std::to_string(mean_));
-        setMetadata("std_dev", std::to_string(std_dev_));
+        stats_ = StatisticsAccumulator();
+        stats_.count = header.count;
+        stats_.mean = header.mean;
+        stats_.m2 = header.stdDev * header.stdDev * static_cast<double>(header.count);
+        stats_.minValue = header.minValue;
+        stats_.maxValue = header.maxValue;
+        publishStatistics();
+    }
+
+    void calculateStatistics() {
+        // Single fused pass (see numeric_kernels.h)
+        stats_ = computeStatistics(data_->data(), data_->size());
+        publishStatistics();
+    }
+
+    void publishStatistics() {
+        if (stats_.count == 0) {
+            min_value_ = max_value_ = mean_ = std_dev_ = 0.0;
+        } else {
+            min_value_ = stats_.minValue;
+            max_value_ = stats_.maxValue;
+            mean_ = stats_.mean;
+            std_dev_ = stats_.stdDev();
+        }
+        statsMetadataDirty_ = true;
+    }
+
+    // ͳԪڶȡʱŸʽ
+    void refreshMetadata() const override {
+        if (!statsMetadataDirty_) return;
+        metadata_["min"] = std::to_string(min_value_);
+        metadata_["max"] = std::to_string(max_value_);
+        metadata_["mean"] = std::to_string(mean_);
+        metadata_["std_dev"] = std::to_string(std_dev_);
+        statsMetadataDirty_ = false;
     }
 };
 
 // ıݼʵ
 class TextDataset : public BaseDataset {
 private:
-    std::vector<std::string> data_;
-    std::map<std::string, size_t> word_frequency_;
+    CopyOnWrite<std::vector<std::string>> data_;
+    CopyOnWrite<LineBuffer> lines_;      // մ洢ģʽµ
+    bool compact_;
+    CopyOnWrite<WordCountTable> wordCounts_;
+
+    // ɵͼƵԼģʽ getData() ʹõַ
+    mutable std::map<std::string, size_t> orderedFrequency_;
+    mutable bool orderedFrequencyValid_ = false;
+    mutable std::vector<std::string> materializedLines_;
+    mutable bool materializedLinesValid_ = false;
+    mutable std::mutex cacheMutex_;
 
 public:
-    TextDataset() : BaseDataset("TextDataset", DataType::TEXT) {}
+    TextDataset() : BaseDataset("TextDataset", DataType::TEXT), compact_(false) {}
+
+    // Shares the data buffers; the on-demand caches start empty
+    TextDataset(const TextDataset& other)
+        : BaseDataset(other)
+        , data_(other.data_)
+        , lines_(other.lines_)
+        , compact_(other.compact_)
+        , wordCounts_(other.wordCounts_) {}
 
     bool load(const std::string& source) override {
-        std::ifstream file(source);
-        if (!file.is_open()) {
-            throw PlatformException("Failed to open file: " + source);
+        auto lock = beginMutation();
+        data_.reset();
+        lines_.reset();
+        compact_ = options_.compactText;
+        if (options_.asyncIO || detectFileCompression(source) != Compression::NONE) {
+            // Split every block into lines as soon as it arrives while the next ones are read
+            forEachLineChunk(source, getLoadChunkBytes(), [this](const char* first, const char* last) {
+                appendLines(first, last);
+            });
+        } else {
+            MappedFile file(source);
+            appendLines(file.begin(), file.end());
         }
-
-        data_.clear();
-        std::string line;
-        while (std::getline(file, line)) {
-            if (!line.empty()) {
-                data_.push_back(line);
-            }
+        if (compact_) {
+            lines_.write().shrinkToFit();
         }
+        setMetadata("storage", compact_ ? "compact" : "strings");
 
         calculateWordFrequency();
-        return !data_.empty();
+        return !isEmpty();
     }
 
     bool validate() const override {
-        return !data_.empty();
+        return !isEmpty();
     }
 
     bool preprocess() override {
-        if (data_.empty()) return false;
-
-        // Basic text preprocessing
-        for (auto& text : data_) {
-            // Convert to lowercase
-            std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+        auto lock = beginMutation();
+        if (isEmpty()) return false;
 
-            // Remove extra spaces
-            auto new_end = std::unique(text.begin(), text.end(),
-                [](char a, char b) {
-                    return std::isspace(a) && std::isspace(b);
-                });
-            text.erase(new_end, text.end());
+        // Basic text preprocessing: lowercase, collapse and trim whitespace
+        // in a single in-place pass per line
+        if (compact_) {
+            // Lines that held only whitespace are dropped, as load() drops empty lines
+            lines_.write().transformInPlace(normalizeText, true);
+        } else {
+            std::vector<std::string>& data = data_.write();
+            for (auto& text : data) {
+                text.resize(normalizeText(&text[0], text.size()));
+            }
 
-            // Trim leading and trailing spaces
-            text = text.substr(text.find_first_not_of(" \t\n\r\f\v"));
-            text = text.substr(0, text.find_last_not_of(" \t\n\r\f\v") + 1);
+            // Lines that held only whitespace are now empty; drop them as load() does
+            data.erase(
+                std::remove_if(data.begin(), data.end(),
+                    [](const std::string& text) { return text.empty(); }),
+                data.end()
+            );
         }
 
         calculateWordFrequency();
@@ -243,55 +800,1929 @@ public:
     }
 
     size_t getSize() const override {
-        return data_.size();
+        return compact_ ? lines_->size() : data_->size();
     }
 
     bool isEmpty() const override {
-        return data_.empty();
+        return getSize() == 0;
     }
 
     void clear() override {
-        data_.clear();
-        word_frequency_.clear();
+        auto lock = beginMutation();
+        data_.reset();
+        lines_.reset();
+        wordCounts_.reset();
+        invalidateCaches();
     }
 
     // Text-specific methods
-    const std::vector<std::string>& getData() const { return data_; }
+    // ִ洢ģʽ¶õ㿽ͼ
+    TextLines getLines() const {
+        return compact_ ? TextLines(*lines_) : TextLines(*data_);
+    }
+
+    bool isCompact() const { return compact_; }
+
+    // ģʽ״εûһ std::string Ӧʹ getLines()
+    const std::vector<std::string>& getData() const {
+        if (!compact_) return *data_;
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        if (!materializedLinesValid_) {
+            materializedLines_.clear();
+            materializedLines_.reserve(lines_->size());
+            for (std::string_view line : getLines()) {
+                materializedLines_.emplace_back(line);
+            }
+            materializedLinesValid_ = true;
+        }
+        return materializedLines_;
+    }
+
+    const WordCountTable& getWordCounts() const { return *wordCounts_; }
+
+    // ֵеĴƵ״εʱɹϣ
     const std::map<std::string, size_t>& getWordFrequency() const { 
-        return word_frequency_; 
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        if (!orderedFrequencyValid_) {
+            orderedFrequency_ = wordCounts_->toOrderedMap();
+            orderedFrequencyValid_ = true;
+        }
+        return orderedFrequency_; 
+    }
+
+protected:
+    std::shared_ptr<BaseDataset> cloneVersion() const override {
+        return std::make_shared<TextDataset>(*this);
     }
 
 private:
+    // Appends the lines of [first, last) to the active storage
+    void appendLines(const char* first, const char* last) {
+        auto chunks = planChunks(first, last);
+        if (compact_) {
+            appendCompact(first, last, chunks);
+        } else if (chunks.size() == 1) {
+            std::vector<std::string>& data = data_.write();
+            if (data.empty()) {
+                data.reserve(countLines(first, last));
+            }
+            collectTextLines(first, last, data);
+        } else {
+            // Split lines per chunk in parallel, then move them into place in order
+            std::vector<std::vector<std::string>> parts(chunks.size());
+            executor().parallelFor(chunks.size(), [&](size_t i) {
+                collectTextLines(chunks[i].first, chunks[i].last, parts[i]);
+            });
+
+            std::vector<std::string>& data = data_.write();
+            if (data.empty()) {
+                size_t total = 0;
+                for (const auto& part : parts) {
+                    total += part.size();
+                }
+                data.reserve(total);
+            }
+            for (auto& part : parts) {
+                std::move(part.begin(), part.end(), std::back_inserter(data));
+            }
+        }
+    }
+
+    void appendCompact(const char* first, const char* last, const std::vector<ByteRange>& chunks) {
+        // Reserve only for the first block; later appends grow geometrically
+        auto collect = [](const ByteRange& range, LineBuffer& out) {
+            if (out.size() == 0) {
+                out.reserve(countLines(range.first, range.last),
+                            static_cast<size_t>(range.last - range.first));
+            }
+            forEachLine(range.first, range.last, [&out](const char* begin, const char* end) {
+                if (begin != end) {
+                    out.append(std::string_view(begin, static_cast<size_t>(end - begin)));
+                }
+            });
+        };
+
+        LineBuffer& lines = lines_.write();
+        if (chunks.size() == 1) {
+            collect(chunks[0], lines);
+        } else {
+            std::vector<LineBuffer> parts(chunks.size());
+            executor().parallelFor(chunks.size(), [&](size_t i) {
+                collect(chunks[i], parts[i]);
+            });
+            if (lines.size() == 0) {
+                lines.reserve(countLines(first, last), static_cast<size_t>(last - first));
+            }
+            for (const auto& part : parts) {
+                lines.append(part);
+            }
+        }
+    }
+
     void calculateWordFrequency() {
-        word_frequency_.clear();
-        for (const auto& text : data_) {
-            std::istringstream iss(text);
-            std::string word;
-            while (iss >> word) {
-                ++word_frequency_[word];
+        const TextLines lines = getLines();
+        size_t shards = 1;
+        if (options_.parallel) {
+            shards = std::min(executor().getConcurrency(),
+                              lines.size() / std::max<size_t>(options_.minChunkLines, 1));
+        }
+
+        if (shards <= 1) {
+            WordCountTable counts(wordCounts_->size());
+            countWords(lines, 0, lines.size(), counts);
+            wordCounts_.reset(std::move(counts));
+        } else {
+            // Map: every shard counts into its own table
+            std::vector<WordCountTable> tables(shards);
+            executor().parallelFor(shards, [&](size_t i) {
+                countWords(lines, i * lines.size() / shards, (i + 1) * lines.size() / shards,
+                           tables[i]);
+            });
+
+            // Reduce: merge pairs of tables per round until one is left
+            for (size_t stride = 1; stride < shards; stride *= 2) {
+                size_t pairs = (shards + 2 * stride - 1) / (2 * stride);
+                executor().parallelFor(pairs, [&](size_t i) {
+                    size_t left = i * 2 * stride;
+                    size_t right = left + stride;
+                    if (right < shards) {
+                        tables[left].merge(tables[right]);
+                        tables[right] = WordCountTable();
+                    }
+                });
             }
+            wordCounts_.reset(std::move(tables[0]));
         }
+        invalidateCaches();
 
         // Update metadata
-        setMetadata("unique_words", std::to_string(word_frequency_.size()));
-        setMetadata("total_words", std::to_string(
-            std::accumulate(word_frequency_.begin(), word_frequency_.end(), 0,
-                [](size_t sum, const auto& pair) {
-                    return sum + pair.second;
-                })
-        ));
+        setMetadata("unique_words", std::to_string(wordCounts_->size()));
+        setMetadata("total_words", std::to_string(wordCounts_->totalWords()));
+    }
+
+    static void countWords(const TextLines& lines, size_t begin, size_t end,
+                           WordCountTable& counts) {
+        for (size_t i = begin; i < end; ++i) {
+            const std::string_view text = lines[i];
+            forEachWord(text.data(), text.data() + text.size(),
+                [&counts](std::string_view word) { counts.add(word); });
+        }
+    }
+
+    void invalidateCaches() {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        orderedFrequency_.clear();
+        orderedFrequencyValid_ = false;
+        materializedLines_.clear();
+        materializedLinesValid_ = false;
     }
 };
 
-// ݼ
-class DatasetFactory {
+// ʽݼࣺļڴ棬ǰڴԤֿȡ
+// ȡռԤһ룬С = memoryBudget / 2 / (readAhead + 2)Ԥ顢ǰ
+// ضϵиռһݣѹļӽĻ壬 decodedSourceBlocks
+// һఴݺͺ
+class StreamingDataset : public BaseDataset {
+protected:
+    std::string source_;
+    size_t size_;
+
 public:
-    static std::shared_ptr<IDataset> createDataset(const std::string& type) {
-        if (type == "NUMERIC") {
-            return std::make_shared<NumericDataset>();
+    StreamingDataset(const std::string& name, DataType type)
+        : BaseDataset(name, type), size_(0) {}
+
+    bool validate() const override {
+        return !source_.empty() && size_ > 0;
+    }
+
+    size_t getSize() const override {
+        return size_;
+    }
+
+    bool isEmpty() const override {
+        return size_ == 0;
+    }
+
+    void clear() override {
+        auto lock = beginMutation();
+        source_.clear();
+        size_ = 0;
+    }
+
+    const std::string& getSource() const { return source_; }
+
+    size_t getChunkBytes() const {
+        const Compression compression = source_.empty() ? Compression::NONE : detectFileCompression(source_);
+        const size_t blocks = decodedSourceBlocks(compression, options_.readAhead) + 2;
+        return std::max<size_t>(options_.memoryBudget / 2 / blocks, 4096);
+    }
+
+protected:
+    // λصԴļÿֻеֽڿ
+    void forEachRawChunk(const std::function<void(const char*, const char*)>& consumer) const {
+        if (source_.empty()) {
+            throw PlatformException("Streaming dataset has no source");
         }
-        else if (type == "TEXT") {
-            return std::make_shared<TextDataset>();
+        forEachLineChunk(source_, getChunkBytes(), consumer);
+    }
+};
+
+// ʽֵݼload() ֻһʽɨõͳݱפڴ
+// ڴԤ㣺ȡռ 1/2ÿֵռ 1/16ͳѡռ 3/8
+class StreamingNumericDataset : public StreamingDataset {
+private:
+    StatisticsAccumulator stats_;
+    size_t skippedLines_;
+    size_t missing_;   // NaN values
+
+public:
+    StreamingNumericDataset()
+        : StreamingDataset("StreamingNumericDataset", DataType::NUMERIC), skippedLines_(0), missing_(0) {}
+
+    bool load(const std::string& source) override {
+        auto lock = beginMutation();
+        source_ = source;
+        stats_ = StatisticsAccumulator();
+        skippedLines_ = 0;
+        missing_ = 0;
+        scanChunks([this](const double* values, size_t count) {
+            stats_.merge(computeStatistics(values, count));
+            missing_ += static_cast<size_t>(std::count_if(values, values + count,
+                                                          [](double x) { return std::isnan(x); }));
+        }, &skippedLines_);
+        size_ = stats_.count;
+
+        setMetadata("skipped_lines", std::to_string(skippedLines_));
+        setMetadata("min", std::to_string(getMinValue()));
+        setMetadata("max", std::to_string(getMaxValue()));
+        setMetadata("mean", std::to_string(getMean()));
+        setMetadata("std_dev", std::to_string(getStdDev()));
+        return size_ > 0;
+    }
+
+    // Դļ޸ģʽݼ֧Ԥ
+    bool preprocess() override {
+        return false;
+    }
+
+    void clear() override {
+        auto lock = beginMutation();
+        StreamingDataset::clear();
+        stats_ = StatisticsAccumulator();
+        skippedLines_ = 0;
+        missing_ = 0;
+    }
+
+    // صֵÿ getValueBatch() 
+    void forEachChunk(const std::function<void(const double*, size_t)>& consumer) const {
+        scanChunks(consumer, nullptr);
+    }
+
+    const StatisticsAccumulator& getStatistics() const { return stats_; }
+    double getMinValue() const { return stats_.count ? stats_.minValue : 0.0; }
+    double getMaxValue() const { return stats_.count ? stats_.maxValue : 0.0; }
+    double getMean() const { return stats_.mean; }
+    double getStdDev() const { return stats_.stdDev(); }
+    size_t getSkippedLines() const { return skippedLines_; }
+    // ֵĸ NaN ֵ
+    size_t getOrderedCount() const { return stats_.count - missing_; }
+
+    size_t getValueBatch() const {
+        return std::max<size_t>(options_.memoryBudget / 16 / sizeof(double), 512);
+    }
+
+    // ͳѡռֱֵͼ
+    size_t getSelectionCapacity() const {
+        return options_.memoryBudget * 3 / 8 / sizeof(double);
+    }
+
+protected:
+    std::shared_ptr<BaseDataset> cloneVersion() const override {
+        return std::make_shared<StreamingNumericDataset>(*this);
+    }
+
+private:
+    // Short lines parse to more bytes than they occupy in the file, so values
+    // are handed out in fixed batches rather than one vector per chunk
+    void scanChunks(const std::function<void(const double*, size_t)>& consumer,
+                    size_t* skippedLines) const {
+        const size_t batch = getValueBatch();
+        std::vector<double> values;
+        values.reserve(batch);
+        forEachRawChunk([&](const char* first, const char* last) {
+            forEachLine(first, last, [&](const char* line, const char* lineEnd) {
+                double value;
+                if (!parseDouble(line, lineEnd, value)) {
+                    if (skippedLines) ++*skippedLines;
+                    return;
+                }
+                values.push_back(value);
+                if (values.size() == batch) {
+                    consumer(values.data(), values.size());
+                    values.clear();
+                }
+            });
+        });
+        if (!values.empty()) {
+            consumer(values.data(), values.size());
+        }
+    }
+};
+
+// ʽıݼ TextLines ͼṩǿУpreprocess() ʹȡʱʱ淶
+class StreamingTextDataset : public StreamingDataset {
+private:
+    bool normalize_;
+
+public:
+    StreamingTextDataset()
+        : StreamingDataset("StreamingTextDataset", DataType::TEXT), normalize_(false) {}
+
+    bool load(const std::string& source) override {
+        auto lock = beginMutation();
+        source_ = source;
+        size_ = 0;
+        forEachChunk([this](const TextLines& lines) {
+            size_ += lines.size();
+        });
+        return size_ > 0;
+    }
+
+    bool preprocess() override {
+        auto lock = beginMutation();
+        if (isEmpty()) return false;
+        normalize_ = true;
+        isPreprocessed_ = true;
+
+        // Normalization can empty some lines, so recount
+        size_ = 0;
+        forEachChunk([this](const TextLines& lines) {
+            size_ += lines.size();
+        });
+        return true;
+    }
+
+    void clear() override {
+        auto lock = beginMutation();
+        StreamingDataset::clear();
+        normalize_ = false;
+    }
+
+    void forEachChunk(const std::function<void(const TextLines&)>& consumer) const {
+        LineBuffer lines;
+        forEachRawChunk([&](const char* first, const char* last) {
+            lines.clear();
+            forEachLine(first, last, [&lines](const char* begin, const char* end) {
+                if (begin != end) {
+                    lines.append(std::string_view(begin, static_cast<size_t>(end - begin)));
+                }
+            });
+            if (normalize_) {
+                lines.transformInPlace(normalizeText, true);
+            }
+            if (!lines.empty()) {
+                consumer(TextLines(lines));
+            }
+        });
+    }
+
+protected:
+    std::shared_ptr<BaseDataset> cloneVersion() const override {
+        return std::make_shared<StreamingTextDataset>(*this);
+    }
+};
+
+// еһУֶ޷ֶζΪȱʧֵ
+class Column {
+protected:
+    std::string name_;
+    DataType type_;
+    size_t invalidCount_;   // ǿյ޷ֶ
+
+public:
+    Column(const std::string& name, DataType type)
+        : name_(name), type_(type), invalidCount_(0) {}
+
+    virtual ~Column() = default;
+
+    const std::string& getName() const { return name_; }
+    DataType getType() const { return type_; }
+    size_t getInvalidCount() const { return invalidCount_; }
+
+    virtual size_t size() const = 0;
+    virtual bool isMissing(size_t row) const = 0;
+    virtual std::string getValueAsString(size_t row) const = 0;
+    virtual size_t getMemoryUsage() const = 0;
+
+    virtual void reserve(size_t rows) = 0;
+    virtual void appendField(std::string_view field) = 0;
+    // Appends the rows of a column of the same type, e.g. a parallel parse chunk
+    virtual void appendColumn(const Column& other) = 0;
+    virtual void filterRows(const std::vector<uint8_t>& keep) = 0;
+    virtual std::unique_ptr<Column> createEmpty() const = 0;
+
+    std::unique_ptr<Column> clone() const {
+        auto copy = createEmpty();
+        copy->reserve(size());
+        copy->appendColumn(*this);
+        return copy;
+    }
+
+protected:
+    template<typename T>
+    static void filterVector(std::vector<T>& values, const std::vector<uint8_t>& keep) {
+        size_t write = 0;
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (keep[i]) values[write++] = values[i];
+        }
+        values.resize(write);
+    }
+};
+
+// ֵУȱʧֵΪ NaN
+class NumericColumn : public Column {
+private:
+    std::vector<double> values_;
+
+public:
+    explicit NumericColumn(const std::string& name) : Column(name, DataType::NUMERIC) {}
+
+    const std::vector<double>& getValues() const { return values_; }
+
+    size_t size() const override { return values_.size(); }
+    bool isMissing(size_t row) const override { return std::isnan(values_[row]); }
+    std::string getValueAsString(size_t row) const override {
+        if (isMissing(row)) return "";
+        std::ostringstream oss;
+        oss << values_[row];
+        return oss.str();
+    }
+    size_t getMemoryUsage() const override { return values_.capacity() * sizeof(double); }
+
+    void reserve(size_t rows) override { values_.reserve(rows); }
+    void appendValue(double value) { values_.push_back(value); }
+
+    // ֶαһƶͬ"12abc" Ϊȱʧֵ invalidCount
+    void appendField(std::string_view field) override {
+        double value;
+        if (parseDoubleField(field.data(), field.data() + field.size(), value)) {
+            values_.push_back(value);
+        } else {
+            if (!field.empty()) ++invalidCount_;
+            values_.push_back(std::numeric_limits<double>::quiet_NaN());
+        }
+    }
+
+    void appendColumn(const Column& other) override {
+        const auto& source = static_cast<const NumericColumn&>(other);
+        values_.insert(values_.end(), source.values_.begin(), source.values_.end());
+        invalidCount_ += source.invalidCount_;
+    }
+
+    void filterRows(const std::vector<uint8_t>& keep) override { filterVector(values_, keep); }
+
+    std::unique_ptr<Column> createEmpty() const override {
+        return std::unique_ptr<Column>(new NumericColumn(name_));
+    }
+};
+
+// ʱУ洢 Unix Ԫ parseDateTime
+class DateTimeColumn : public Column {
+private:
+    std::vector<int64_t> values_;
+
+public:
+    static constexpr int64_t MISSING = std::numeric_limits<int64_t>::min();
+
+    explicit DateTimeColumn(const std::string& name) : Column(name, DataType::DATETIME) {}
+
+    const std::vector<int64_t>& getValues() const { return values_; }
+
+    size_t size() const override { return values_.size(); }
+    bool isMissing(size_t row) const override { return values_[row] == MISSING; }
+    std::string getValueAsString(size_t row) const override {
+        return isMissing(row) ? "" : formatDateTime(values_[row]);
+    }
+    size_t getMemoryUsage() const override { return values_.capacity() * sizeof(int64_t); }
+
+    void reserve(size_t rows) override { values_.reserve(rows); }
+    void appendValue(int64_t value) { values_.push_back(value); }
+
+    void appendField(std::string_view field) override {
+        int64_t value;
+        if (parseDateTime(field.data(), field.data() + field.size(), value) && value != MISSING) {
+            values_.push_back(value);
+        } else {
+            if (!field.empty()) ++invalidCount_;
+            values_.push_back(MISSING);
+        }
+    }
+
+    void appendColumn(const Column& other) override {
+        const auto& source = static_cast<const DateTimeColumn&>(other);
+        values_.insert(values_.end(), source.values_.begin(), source.values_.end());
+        invalidCount_ += source.invalidCount_;
+    }
+
+    void filterRows(const std::vector<uint8_t>& keep) override { filterVector(values_, keep); }
+
+    std::unique_ptr<Column> createEmpty() const override {
+        return std::unique_ptr<Column>(new DateTimeColumn(name_));
+    }
+};
+
+// Уֵ룬ÿֻ 32 λ룬ֵַֻбһ
+class CategoricalColumn : public Column {
+private:
+    std::vector<uint32_t> codes_;
+    std::vector<std::string_view> categories_;   // ָ arena_
+    std::unordered_map<std::string_view, uint32_t> lookup_;
+    StringArena arena_;
+
+public:
+    static constexpr uint32_t MISSING = std::numeric_limits<uint32_t>::max();
+
+    explicit CategoricalColumn(const std::string& name) : Column(name, DataType::CATEGORICAL) {}
+
+    // The copy gets its own dictionary; categories_ must point into its own arena
+    CategoricalColumn(const CategoricalColumn& other)
+        : Column(other), codes_(other.codes_) {
+        categories_.reserve(other.categories_.size());
+        for (std::string_view category : other.categories_) intern(category);
+    }
+    CategoricalColumn(CategoricalColumn&&) = default;
+    CategoricalColumn& operator=(CategoricalColumn&&) = default;
+
+    const std::vector<uint32_t>& getCodes() const { return codes_; }
+    const std::vector<std::string_view>& getCategories() const { return categories_; }
+    size_t getCategoryCount() const { return categories_.size(); }
+
+    // Returns the code of a category, adding it to the dictionary if needed
+    uint32_t intern(std::string_view category) {
+        auto it = lookup_.find(category);
+        if (it != lookup_.end()) return it->second;
+        const uint32_t code = static_cast<uint32_t>(categories_.size());
+        const std::string_view stored = arena_.store(category);
+        categories_.push_back(stored);
+        lookup_.emplace(stored, code);
+        return code;
+    }
+
+    size_t size() const override { return codes_.size(); }
+    bool isMissing(size_t row) const override { return codes_[row] == MISSING; }
+    std::string getValueAsString(size_t row) const override {
+        return isMissing(row) ? "" : std::string(categories_[codes_[row]]);
+    }
+    size_t getMemoryUsage() const override {
+        return codes_.capacity() * sizeof(uint32_t) + arena_.getBytesUsed() +
+               categories_.capacity() * sizeof(std::string_view) +
+               lookup_.size() * (sizeof(std::string_view) + sizeof(uint32_t) + sizeof(void*));
+    }
+
+    void reserve(size_t rows) override { codes_.reserve(rows); }
+
+    void appendField(std::string_view field) override {
+        codes_.push_back(field.empty() ? MISSING : intern(field));
+    }
+
+    void appendColumn(const Column& other) override {
+        // The other chunk has its own dictionary; translate its codes to ours
+        const auto& source = static_cast<const CategoricalColumn&>(other);
+        std::vector<uint32_t> remap(source.categories_.size());
+        for (size_t i = 0; i < remap.size(); ++i) {
+            remap[i] = intern(source.categories_[i]);
+        }
+        codes_.reserve(codes_.size() + source.codes_.size());
+        for (uint32_t code : source.codes_) {
+            codes_.push_back(code == MISSING ? MISSING : remap[code]);
+        }
+        invalidCount_ += source.invalidCount_;
+    }
+
+    void filterRows(const std::vector<uint8_t>& keep) override { filterVector(codes_, keep); }
+
+    std::unique_ptr<Column> createEmpty() const override {
+        return std::unique_ptr<Column>(new CategoricalColumn(name_));
+    }
+};
+
+// ıУֵһ LineBuffer Уַȱʧֵ
+class TextColumn : public Column {
+private:
+    LineBuffer values_;
+
+public:
+    explicit TextColumn(const std::string& name) : Column(name, DataType::TEXT) {}
+
+    std::string_view getValue(size_t row) const { return values_[row]; }
+    const LineBuffer& getValues() const { return values_; }
+
+    size_t size() const override { return values_.size(); }
+    bool isMissing(size_t row) const override { return values_[row].empty(); }
+    std::string getValueAsString(size_t row) const override { return std::string(values_[row]); }
+    size_t getMemoryUsage() const override { return values_.getMemoryUsage(); }
+
+    void reserve(size_t rows) override { values_.reserve(rows, 0); }
+
+    void appendField(std::string_view field) override { values_.append(field); }
+
+    void appendColumn(const Column& other) override {
+        values_.append(static_cast<const TextColumn&>(other).values_);
+    }
+
+    void filterRows(const std::vector<uint8_t>& keep) override {
+        LineBuffer kept;
+        for (size_t i = 0; i < values_.size(); ++i) {
+            if (keep[i]) kept.append(values_[i]);
+        }
+        values_ = std::move(kept);
+    }
+
+    std::unique_ptr<Column> createEmpty() const override {
+        return std::unique_ptr<Column>(new TextColumn(name_));
+    }
+};
+
+inline std::unique_ptr<Column> createColumn(const std::string& name, DataType type) {
+    switch (type) {
+        case DataType::NUMERIC: return std::unique_ptr<Column>(new NumericColumn(name));
+        case DataType::CATEGORICAL: return std::unique_ptr<Column>(new CategoricalColumn(name));
+        case DataType::DATETIME: return std::unique_ptr<Column>(new DateTimeColumn(name));
+        case DataType::TEXT: return std::unique_ptr<Column>(new TextColumn(name));
+        default: throw PlatformException("Unsupported column type");
+    }
+}
+
+// ʽݼCSV/TSV
+// ÿнΪͻδѡеڽʱֻλָκת
+// δ͵иǰ TYPE_SAMPLE_ROWS ƶϣֵ > ʱ > ֵࣨͬһ룩> ı
+class TableDataset : public BaseDataset {
+private:
+    static constexpr size_t TYPE_SAMPLE_ROWS = 1000;
+
+    CsvDialect dialect_;
+    std::vector<std::string> selectedColumns_;      // Ϊձʾȫ
+    std::map<std::string, DataType> declaredTypes_;
+    std::vector<std::string> fileColumns_;          // ļеȫ
+    std::vector<CopyOnWrite<Column>> columns_;      // ѡеУļе˳򣻿չЩ
+    size_t rows_;
+
+public:
+    TableDataset() : BaseDataset("TableDataset", DataType::TABLE), rows_(0) {}
+
+    void setDialect(const CsvDialect& dialect) { dialect_ = dialect; }
+    const CsvDialect& getDialect() const { return dialect_; }
+
+    // ֻЩУ load() ֮ǰ
+    void selectColumns(const std::vector<std::string>& names) { selectedColumns_ = names; }
+    void setColumnType(const std::string& name, DataType type) { declaredTypes_[name] = type; }
+
+    bool load(const std::string& source) override {
+        auto lock = beginMutation();
+        clear();
+
+        MappedFile file(source);
+        std::vector<char> decoded;
+        const char* first = file.begin();
+        const char* last = file.end();
+        if (detectCompression(file.data(), file.size()) != Compression::NONE) {
+            // Quoted fields may span lines, so decode everything before parsing
+            auto input = openDecodedSource(source, options_.minChunkBytes, options_.readAhead,
+                                           options_.asyncIO, &executor());
+            size_t filled = 0;
+            while (true) {
+                decoded.resize(std::max(filled + options_.minChunkBytes, decoded.size()));
+                size_t n = input->read(decoded.data() + filled, decoded.size() - filled);
+                if (n == 0) break;
+                filled += n;
+            }
+            first = decoded.data();
+            last = first + filled;
+        }
+
+        // UTF-8 byte order mark
+        if (last - first >= 3 && std::memcmp(first, "\xEF\xBB\xBF", 3) == 0) {
+            first += 3;
+        }
+        while (first < last && (*first == '\n' || *first == '\r')) ++first;
+        if (first == last) return false;
+
+        CsvDialect dialect = dialect_;
+        if (dialect.delimiter == '\0') {
+            dialect.delimiter = detectDelimiter(first, last);
+        }
+
+        // Column names
+        const char* body = first;
+        std::string scratch;
+        std::vector<std::string> names;
+        const char* next = parseCsvRecord(first, last, dialect,
+            [&](size_t index, const char* begin, const char* end, bool quoted) {
+                if (!dialect.hasHeader) {
+                    names.push_back("column_" + std::to_string(index));
+                } else if (quoted) {
+                    names.emplace_back(unescapeCsvField(begin, end, dialect.quote, scratch));
+                } else {
+                    names.emplace_back(begin, end);
+                }
+            });
+        if (dialect.hasHeader) body = next;
+        fileColumns_ = names;
+
+        // File column index -> position in columns_, -1 when not selected
+        std::vector<int> slots(fileColumns_.size(), -1);
+        std::vector<size_t> selected;
+        for (size_t i = 0; i < fileColumns_.size(); ++i) {
+            if (selectedColumns_.empty() ||
+                std::find(selectedColumns_.begin(), selectedColumns_.end(), fileColumns_[i]) != selectedColumns_.end()) {
+                slots[i] = static_cast<int>(selected.size());
+                selected.push_back(i);
+            }
+        }
+        for (const auto& name : selectedColumns_) {
+            if (std::find(fileColumns_.begin(), fileColumns_.end(), name) == fileColumns_.end()) {
+                throw PlatformException("Unknown column: " + name);
+            }
+        }
+
+        std::vector<DataType> types = inferTypes(body, last, dialect, slots, selected.size());
+        std::vector<std::unique_ptr<Column>> columns;
+        for (size_t i = 0; i < selected.size(); ++i) {
+            columns.push_back(createColumn(fileColumns_[selected[i]], types[i]));
+        }
+
+        // Chunks can only be cut at line breaks when no field is quoted
+        auto chunks = planChunks(body, last);
+        if (chunks.size() > 1 && dialect.quote != '\0' &&
+            std::memchr(body, dialect.quote, static_cast<size_t>(last - body))) {
+            chunks = {ByteRange{body, last}};
+        }
+
+        if (chunks.size() == 1) {
+            for (auto& column : columns) column->reserve(countLines(body, last));
+            rows_ = parseRows(body, last, dialect, slots, columns);
+        } else {
+            std::vector<std::vector<std::unique_ptr<Column>>> parts(chunks.size());
+            std::vector<size_t> rows(chunks.size(), 0);
+            executor().parallelFor(chunks.size(), [&](size_t i) {
+                for (const auto& column : columns) {
+                    parts[i].push_back(column->createEmpty());
+                    parts[i].back()->reserve(countLines(chunks[i].first, chunks[i].last));
+                }
+                rows[i] = parseRows(chunks[i].first, chunks[i].last, dialect, slots, parts[i]);
+            });
+
+            rows_ = std::accumulate(rows.begin(), rows.end(), size_t(0));
+            executor().parallelFor(columns.size(), [&](size_t c) {
+                columns[c]->reserve(rows_);
+                for (auto& part : parts) {
+                    columns[c]->appendColumn(*part[c]);
+                    part[c].reset();
+                }
+            });
+        }
+
+        columns_.clear();
+        for (auto& column : columns) {
+            columns_.emplace_back(std::shared_ptr<Column>(std::move(column)));
+        }
+        updateMetadata();
+        return rows_ > 0;
+    }
+
+    bool validate() const override {
+        return rows_ > 0 && !columns_.empty();
+    }
+
+    // ɾһѡȱʧ
+    bool preprocess() override {
+        auto lock = beginMutation();
+        if (isEmpty()) return false;
+
+        std::vector<uint8_t> keep(rows_, 1);
+        for (const auto& column : columns_) {
+            for (size_t row = 0; row < rows_; ++row) {
+                if (keep[row] && column->isMissing(row)) keep[row] = 0;
+            }
+        }
+        const size_t kept = static_cast<size_t>(std::count(keep.begin(), keep.end(), 1));
+        if (kept != rows_) {
+            executor().parallelFor(columns_.size(), [&](size_t c) {
+                // Columns still shared with a snapshot are copied first
+                columns_[c].write().filterRows(keep);
+            });
+            rows_ = kept;
+        }
+        updateMetadata();
+        isPreprocessed_ = true;
+        return rows_ > 0;
+    }
+
+    size_t getSize() const override {
+        return rows_;
+    }
+
+    bool isEmpty() const override {
+        return rows_ == 0;
+    }
+
+    void clear() override {
+        auto lock = beginMutation();
+        fileColumns_.clear();
+        columns_.clear();
+        rows_ = 0;
+    }
+
+    size_t getColumnCount() const { return columns_.size(); }
+    const Column& getColumn(size_t index) const { return *columns_.at(index); }
+    const std::vector<std::string>& getFileColumns() const { return fileColumns_; }
+
+    const Column* findColumn(const std::string& name) const {
+        for (const auto& column : columns_) {
+            if (column->getName() == name) return &*column;
+        }
+        return nullptr;
+    }
+
+    // ȡָ͵УƻͲʱ nullptr
+    template<typename ColumnType>
+    const ColumnType* getColumnAs(const std::string& name) const {
+        return dynamic_cast<const ColumnType*>(findColumn(name));
+    }
+
+protected:
+    std::shared_ptr<BaseDataset> cloneVersion() const override {
+        return std::make_shared<TableDataset>(*this);
+    }
+
+private:
+    static char detectDelimiter(const char* first, const char* last) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(first, '\n', static_cast<size_t>(last - first)));
+        if (!lineEnd) lineEnd = last;
+        const auto tabs = std::count(first, lineEnd, '\t');
+        const auto commas = std::count(first, lineEnd, ',');
+        return (tabs > 0 && tabs >= commas) ? '\t' : ',';
+    }
+
+    // Parses every record in [first, last) into columns; returns the number of rows
+    static size_t parseRows(const char* first, const char* last, const CsvDialect& dialect,
+                            const std::vector<int>& slots,
+                            std::vector<std::unique_ptr<Column>>& columns) {
+        std::string scratch;
+        size_t rows = 0;
+        const char* p = first;
+        while (p < last) {
+            if (*p == '\n' || *p == '\r') {
+                ++p;   // blank line
+                continue;
+            }
+            size_t fields = 0;
+            p = parseCsvRecord(p, last, dialect,
+                [&](size_t index, const char* begin, const char* end, bool quoted) {
+                    fields = index + 1;
+                    if (index >= slots.size() || slots[index] < 0) return;
+                    const std::string_view value = quoted
+                        ? unescapeCsvField(begin, end, dialect.quote, scratch)
+                        : std::string_view(begin, static_cast<size_t>(end - begin));
+                    columns[static_cast<size_t>(slots[index])]->appendField(value);
+                });
+            // Short rows are padded with missing values
+            for (size_t i = fields; i < slots.size(); ++i) {
+                if (slots[i] >= 0) columns[static_cast<size_t>(slots[i])]->appendField(std::string_view());
+            }
+            ++rows;
+        }
+        return rows;
+    }
+
+    std::vector<DataType> inferTypes(const char* first, const char* last, const CsvDialect& dialect,
+                                     const std::vector<int>& slots, size_t columnCount) const {
+        std::vector<DataType> types(columnCount, DataType::UNDEFINED);
+        bool needsSample = false;
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (slots[i] < 0) continue;
+            auto it = declaredTypes_.find(fileColumns_[i]);
+            if (it != declaredTypes_.end()) {
+                types[static_cast<size_t>(slots[i])] = it->second;
+            } else {
+                needsSample = true;
+            }
+        }
+        if (!needsSample) return types;
+
+        std::vector<size_t> values(columnCount, 0);
+        std::vector<uint8_t> numeric(columnCount, 1), datetime(columnCount, 1);
+        std::vector<std::set<std::string>> distinct(columnCount);
+        std::string scratch;
+        const char* p = first;
+        for (size_t row = 0; row < TYPE_SAMPLE_ROWS && p < last; ) {
+            if (*p == '\n' || *p == '\r') {
+                ++p;
+                continue;
+            }
+            p = parseCsvRecord(p, last, dialect,
+                [&](size_t index, const char* begin, const char* end, bool quoted) {
+                    if (index >= slots.size() || slots[index] < 0) return;
+                    const size_t c = static_cast<size_t>(slots[index]);
+                    if (types[c] != DataType::UNDEFINED || begin == end) return;
+                    const std::string_view value = quoted
+                        ? unescapeCsvField(begin, end, dialect.quote, scratch)
+                        : std::string_view(begin, static_cast<size_t>(end - begin));
+                    int64_t nanos;
+                    ++values[c];
+                    if (numeric[c] && !isNumberField(value)) numeric[c] = 0;
+                    if (datetime[c] && !parseDateTime(value.data(), value.data() + value.size(), nanos)) datetime[c] = 0;
+                    distinct[c].emplace(value);
+                });
+            ++row;
+        }
+
+        for (size_t c = 0; c < columnCount; ++c) {
+            if (types[c] != DataType::UNDEFINED) continue;
+            if (values[c] == 0) types[c] = DataType::TEXT;
+            else if (numeric[c]) types[c] = DataType::NUMERIC;
+            else if (datetime[c]) types[c] = DataType::DATETIME;
+            else if (distinct[c].size() * 2 <= values[c]) types[c] = DataType::CATEGORICAL;
+            else types[c] = DataType::TEXT;
+        }
+        return types;
+    }
+
+    // The same whole-field rule NumericColumn::appendField applies, so that
+    // e.g. dates are not taken for numbers during type inference
+    static bool isNumberField(std::string_view field) {
+        double value;
+        return parseDoubleField(field.data(), field.data() + field.size(), value);
+    }
+
+    void updateMetadata() {
+        std::ostringstream types;
+        size_t invalid = 0;
+        for (size_t i = 0; i < columns_.size(); ++i) {
+            if (i > 0) types << ",";
+            types << columns_[i]->getName() << ":" << toString(columns_[i]->getType());
+            invalid += columns_[i]->getInvalidCount();
+        }
+        setMetadata("rows", std::to_string(rows_));
+        setMetadata("columns", std::to_string(columns_.size()));
+        setMetadata("column_types", types.str());
+        setMetadata("invalid_fields", std::to_string(invalid));
+    }
+};
+
+// ݼÿһֵֵ洢 CategoricalColumn
+// βĿհױȥмΪȱʧֵ
+class CategoricalDataset : public BaseDataset {
+private:
+    CopyOnWrite<CategoricalColumn> column_;
+
+public:
+    CategoricalDataset()
+        : BaseDataset("CategoricalDataset", DataType::CATEGORICAL), column_(CategoricalColumn("value")) {}
+
+    bool load(const std::string& source) override {
+        auto lock = beginMutation();
+        column_.reset(CategoricalColumn("value"));
+        CategoricalColumn& column = column_.write();
+
+        auto collect = [](const char* first, const char* last, CategoricalColumn& out) {
+            out.reserve(countLines(first, last));
+            forEachLine(first, last, [&out](const char* begin, const char* end) {
+                while (begin < end && isAsciiSpace(static_cast<unsigned char>(*begin))) ++begin;
+                while (end > begin && isAsciiSpace(static_cast<unsigned char>(end[-1]))) --end;
+                out.appendField(std::string_view(begin, static_cast<size_t>(end - begin)));
+            });
+        };
+
+        auto loadRange = [&](const char* first, const char* last) {
+            auto chunks = planChunks(first, last);
+            if (chunks.size() == 1) {
+                collect(first, last, column);
+                return;
+            }
+            // Every chunk builds its own dictionary; codes are remapped while merging
+            std::vector<CategoricalColumn> parts;
+            parts.reserve(chunks.size());
+            for (size_t i = 0; i < chunks.size(); ++i) {
+                parts.emplace_back("value");
+            }
+            executor().parallelFor(chunks.size(), [&](size_t i) {
+                collect(chunks[i].first, chunks[i].last, parts[i]);
+            });
+            for (const auto& part : parts) {
+                column.appendColumn(part);
+            }
+        };
+
+        if (options_.asyncIO || detectFileCompression(source) != Compression::NONE) {
+            forEachLineChunk(source, getLoadChunkBytes(), loadRange);
+        } else {
+            MappedFile file(source);
+            loadRange(file.begin(), file.end());
+        }
+
+        updateMetadata();
+        return !isEmpty();
+    }
+
+    bool validate() const override {
+        return !isEmpty();
+    }
+
+    // ɾȱʧֵ
+    bool preprocess() override {
+        auto lock = beginMutation();
+        if (isEmpty()) return false;
+
+        const auto& codes = column_->getCodes();
+        std::vector<uint8_t> keep(codes.size());
+        for (size_t i = 0; i < codes.size(); ++i) {
+            keep[i] = codes[i] != CategoricalColumn::MISSING;
+        }
+        column_.write().filterRows(keep);
+        updateMetadata();
+        isPreprocessed_ = true;
+        return !isEmpty();
+    }
+
+    size_t getSize() const override {
+        return column_->size();
+    }
+
+    bool isEmpty() const override {
+        return column_->size() == 0;
+    }
+
+    void clear() override {
+        auto lock = beginMutation();
+        column_.reset(CategoricalColumn("value"));
+    }
+
+    const CategoricalColumn& getColumn() const { return *column_; }
+    const std::vector<uint32_t>& getCodes() const { return column_->getCodes(); }
+    const std::vector<std::string_view>& getCategories() const { return column_->getCategories(); }
+    size_t getCategoryCount() const { return column_->getCategoryCount(); }
+
+protected:
+    std::shared_ptr<BaseDataset> cloneVersion() const override {
+        return std::make_shared<CategoricalDataset>(*this);
+    }
+
+private:
+    void updateMetadata() {
+        const auto& codes = column_->getCodes();
+        setMetadata("categories", std::to_string(column_->getCategoryCount()));
+        setMetadata("missing_values", std::to_string(
+            std::count(codes.begin(), codes.end(), CategoricalColumn::MISSING)));
+    }
+};
+
+// ʱݼÿһʱISO-8601  Unix 룬 parseDateTime
+// ڶŻƱһֵʱ int64 洢޷б
+class DateTimeDataset : public BaseDataset {
+private:
+    CopyOnWrite<DateTimeColumn> times_;
+    CopyOnWrite<NumericColumn> values_;      // ûκдֵʱΪ
+    bool sorted_;
+    size_t skippedLines_;
+
+public:
+    DateTimeDataset()
+        : BaseDataset("DateTimeDataset", DataType::DATETIME)
+        , times_(DateTimeColumn("time")), values_(NumericColumn("value")), sorted_(true), skippedLines_(0) {}
+
+    bool load(const std::string& source) override {
+        auto lock = beginMutation();
+        clear();
+        DateTimeColumn& timeColumn = times_.write();
+        NumericColumn& valueColumn = values_.write();
+
+        struct Part {
+            DateTimeColumn times{"time"};
+            NumericColumn values{"value"};
+            bool hasValues = false;
+            size_t skipped = 0;
+        };
+        auto collect = [](const char* first, const char* last, Part& out) {
+            out.times.reserve(countLines(first, last));
+            forEachLine(first, last, [&out](const char* begin, const char* end) {
+                const char* separator = begin;
+                while (separator < end && *separator != ',' && *separator != '\t') ++separator;
+                int64_t time;
+                if (!parseDateTime(begin, separator, time) || time == DateTimeColumn::MISSING) {
+                    // Blank lines are not counted as invalid
+                    if (separator != begin && !(end - begin == 1 && *begin == '\r')) ++out.skipped;
+                    return;
+                }
+                out.times.appendValue(time);
+                if (separator < end) {
+                    // Rows before the first value are padded with NaN
+                    if (!out.hasValues) {
+                        for (size_t i = 1; i < out.times.size(); ++i) out.values.appendField(std::string_view());
+                        out.hasValues = true;
+                    }
+                    out.values.appendField(std::string_view(separator + 1, static_cast<size_t>(end - separator - 1)));
+                } else if (out.hasValues) {
+                    out.values.appendField(std::string_view());
+                }
+            });
+        };
+
+        bool hasValues = false;
+        auto loadRange = [&](const char* first, const char* last) {
+            auto chunks = planChunks(first, last);
+            std::vector<Part> parts(chunks.size());
+            executor().parallelFor(chunks.size(), [&](size_t i) {
+                collect(chunks[i].first, chunks[i].last, parts[i]);
+            });
+            for (auto& part : parts) {
+                if (part.hasValues && !hasValues) {
+                    padValues(valueColumn, timeColumn.size());
+                    hasValues = true;
+                }
+                if (hasValues) {
+                    if (part.hasValues) {
+                        valueColumn.appendColumn(part.values);
+                    } else {
+                        padValues(valueColumn, valueColumn.size() + part.times.size());
+                    }
+                }
+                timeColumn.appendColumn(part.times);
+                skippedLines_ += part.skipped;
+            }
+        };
+
+        if (options_.asyncIO || detectFileCompression(source) != Compression::NONE) {
+            forEachLineChunk(source, getLoadChunkBytes(), loadRange);
+        } else {
+            MappedFile file(source);
+            loadRange(file.begin(), file.end());
+        }
+
+        const auto& times = timeColumn.getValues();
+        sorted_ = std::is_sorted(times.begin(), times.end());
+        updateMetadata();
+        return !isEmpty();
+    }
+
+    bool validate() const override {
+        return !isEmpty();
+    }
+
+    // ʱȶֵʱһƶ
+    bool preprocess() override {
+        auto lock = beginMutation();
+        if (isEmpty()) return false;
+
+        if (!sorted_) {
+            const auto order = getSortedOrder();
+            DateTimeColumn times("time");
+            NumericColumn values("value");
+            times.reserve(order.size());
+            values.reserve(hasValues() ? order.size() : 0);
+            for (size_t row : order) {
+                times.appendValue(times_->getValues()[row]);
+                if (hasValues()) values.appendValue(values_->getValues()[row]);
+            }
+            times_.reset(std::move(times));
+            values_.reset(std::move(values));
+            sorted_ = true;
+        }
+        updateMetadata();
+        isPreprocessed_ = true;
+        return true;
+    }
+
+    size_t getSize() const override {
+        return times_->size();
+    }
+
+    bool isEmpty() const override {
+        return times_->size() == 0;
+    }
+
+    void clear() override {
+        auto lock = beginMutation();
+        times_.reset(DateTimeColumn("time"));
+        values_.reset(NumericColumn("value"));
+        sorted_ = true;
+        skippedLines_ = 0;
+    }
+
+    const std::vector<int64_t>& getTimestamps() const { return times_->getValues(); }
+    const std::vector<double>& getValues() const { return values_->getValues(); }
+    bool hasValues() const { return values_->size() > 0; }
+    bool isSorted() const { return sorted_; }
+    size_t getSkippedLines() const { return skippedLines_; }
+
+    // ʱ±꣨ʱͬԭ˳
+    std::vector<size_t> getSortedOrder() const {
+        return sortedTimeOrder(times_->getValues());
+    }
+
+protected:
+    std::shared_ptr<BaseDataset> cloneVersion() const override {
+        return std::make_shared<DateTimeDataset>(*this);
+    }
+
+private:
+    static void padValues(NumericColumn& values, size_t rows) {
+        while (values.size() < rows) values.appendValue(std::numeric_limits<double>::quiet_NaN());
+    }
+
+    void updateMetadata() {
+        setMetadata("sorted", sorted_ ? "true" : "false");
+        setMetadata("has_values", hasValues() ? "true" : "false");
+        setMetadata("skipped_lines", std::to_string(skippedLines_));
+        const auto& times = times_->getValues();
+        if (!times.empty()) {
+            auto range = std::minmax_element(times.begin(), times.end());
+            setMetadata("first", formatDateTime(*range.first));
+            setMetadata("last", formatDateTime(*range.second));
+        }
+    }
+};
+
+// ܾݼÿһΪֵ洢
+// ֶԶŻհ׷ָһвȫΪֵʱΪ
+// ɵһо򺬷Ƿֶεб
+class MatrixDataset : public BaseDataset {
+private:
+    static constexpr size_t TRANSPOSE_BLOCK = 64;
+
+    CopyOnWrite<std::vector<double>> values_;
+    std::vector<std::string> columnNames_;
+    size_t columns_;
+    size_t skippedLines_;
+
+public:
+    MatrixDataset()
+        : BaseDataset("MatrixDataset", DataType::MATRIX), columns_(0), skippedLines_(0) {}
+
+    bool load(const std::string& source) override {
+        auto lock = beginMutation();
+        clear();
+        std::vector<double>& values = values_.write();
+
+        auto loadRange = [&](const char* first, const char* last) {
+            if (columns_ == 0) {
+                first = readHeader(first, last);
+                if (columns_ == 0) return;
+            }
+            auto chunks = planChunks(first, last);
+            std::vector<std::vector<double>> parts(chunks.size());
+            std::vector<size_t> skipped(chunks.size(), 0);
+            executor().parallelFor(chunks.size(), [&](size_t i) {
+                skipped[i] = parseRows(chunks[i].first, chunks[i].last, columns_, parts[i]);
+            });
+            for (size_t i = 0; i < parts.size(); ++i) {
+                values.insert(values.end(), parts[i].begin(), parts[i].end());
+                skippedLines_ += skipped[i];
+            }
+        };
+
+        if (options_.asyncIO || detectFileCompression(source) != Compression::NONE) {
+            forEachLineChunk(source, getLoadChunkBytes(), loadRange);
+        } else {
+            MappedFile file(source);
+            loadRange(file.begin(), file.end());
+        }
+
+        updateMetadata();
+        return !isEmpty();
+    }
+
+    // ֱþݣvalues ȴ rows  columns ֵ
+    void assign(std::vector<double> values, size_t columns,
+                std::vector<std::string> columnNames = std::vector<std::string>()) {
+        if (columns == 0 || values.size() % columns != 0) {
+            throw PlatformException("Matrix size is not a multiple of the column count");
+        }
+        if (!columnNames.empty() && columnNames.size() != columns) {
+            throw PlatformException("Matrix column names do not match the column count");
+        }
+        auto lock = beginMutation();
+        clear();
+        values_.reset(std::move(values));
+        columns_ = columns;
+        columnNames_ = columnNames.empty() ? defaultColumnNames(columns) : std::move(columnNames);
+        updateMetadata();
+    }
+
+    bool validate() const override {
+        return !isEmpty();
+    }
+
+    // ɾȱʧֵNaN
+    bool preprocess() override {
+        auto lock = beginMutation();
+        if (isEmpty()) return false;
+
+        const std::vector<double>& current = *values_;
+        std::vector<double> kept;
+        kept.reserve(current.size());
+        for (size_t offset = 0; offset < current.size(); offset += columns_) {
+            const double* row = current.data() + offset;
+            if (std::none_of(row, row + columns_, [](double x) { return std::isnan(x); })) {
+                kept.insert(kept.end(), row, row + columns_);
+            }
+        }
+        values_.reset(std::move(kept));
+        updateMetadata();
+        isPreprocessed_ = true;
+        return !isEmpty();
+    }
+
+    size_t getSize() const override {
+        return columns_ == 0 ? 0 : values_->size() / columns_;
+    }
+
+    bool isEmpty() const override {
+        return values_->empty();
+    }
+
+    void clear() override {
+        auto lock = beginMutation();
+        values_.reset();
+        columnNames_.clear();
+        columns_ = 0;
+        skippedLines_ = 0;
+    }
+
+    size_t getColumnCount() const { return columns_; }
+    const std::vector<std::string>& getColumnNames() const { return columnNames_; }
+    const std::vector<double>& getValues() const { return *values_; }
+    const double* getRow(size_t row) const { return values_->data() + row * columns_; }
+    size_t getSkippedLines() const { return skippedLines_; }
+
+    // ȣSoAƣе c д c * getSize() ʼпƬת
+    std::vector<double> getColumnMajor() const {
+        const size_t rows = getSize();
+        const double* source = values_->data();
+        std::vector<double> out(values_->size());
+        const size_t blocks = (rows + TRANSPOSE_BLOCK - 1) / TRANSPOSE_BLOCK;
+        executor().parallelFor(blocks, [&](size_t b) {
+            const size_t first = b * TRANSPOSE_BLOCK;
+            const size_t last = std::min(rows, first + TRANSPOSE_BLOCK);
+            for (size_t c = 0; c < columns_; ++c) {
+                double* column = out.data() + c * rows;
+                for (size_t r = first; r < last; ++r) {
+                    column[r] = source[r * columns_ + c];
+                }
+            }
+        });
+        return out;
+    }
+
+protected:
+    std::shared_ptr<BaseDataset> cloneVersion() const override {
+        return std::make_shared<MatrixDataset>(*this);
+    }
+
+private:
+    // صһеֶΣŻհ׷ֶָǰĿհױԣֶ
+    template<typename Callback>
+    static size_t forEachField(const char* p, const char* end, Callback&& callback) {
+        size_t count = 0;
+        while (true) {
+            while (p < end && isAsciiSpace(static_cast<unsigned char>(*p))) ++p;
+            if (p == end) break;
+            const char* fieldEnd = p;
+            while (fieldEnd < end && *fieldEnd != ',' && !isAsciiSpace(static_cast<unsigned char>(*fieldEnd))) {
+                ++fieldEnd;
+            }
+            callback(p, fieldEnd);
+            ++count;
+            p = fieldEnd;
+            while (p < end && isAsciiSpace(static_cast<unsigned char>(*p))) ++p;
+            if (p < end && *p == ',') ++p;
+        }
+        return count;
+    }
+
+    static bool isBlank(const char* begin, const char* end) {
+        return std::all_of(begin, end, [](char c) { return isAsciiSpace(static_cast<unsigned char>(c)); });
+    }
+
+    static std::vector<std::string> defaultColumnNames(size_t columns) {
+        std::vector<std::string> names;
+        for (size_t i = 0; i < columns; ++i) {
+            names.push_back("column_" + std::to_string(i));
+        }
+        return names;
+    }
+
+    // Takes the column count (and names) from the first non-blank line;
+    // returns where the data rows start
+    const char* readHeader(const char* first, const char* last) {
+        const char* p = first;
+        while (p < last) {
+            const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(last - p)));
+            const char* lineEnd = nl ? nl : last;
+            const char* next = nl ? nl + 1 : last;
+            if (isBlank(p, lineEnd)) {
+                p = next;
+                continue;
+            }
+            std::vector<std::string> names;
+            bool numeric = true;
+            columns_ = forEachField(p, lineEnd, [&](const char* begin, const char* end) {
+                double value;
+                numeric = numeric && parseDoubleField(begin, end, value);
+                names.emplace_back(begin, end);
+            });
+            columnNames_ = numeric ? defaultColumnNames(columns_) : std::move(names);
+            return numeric ? p : next;
+        }
+        return last;
+    }
+
+    // Appends every row with exactly `columns` numeric fields; returns the number of skipped rows
+    static size_t parseRows(const char* first, const char* last, size_t columns, std::vector<double>& out) {
+        size_t skipped = 0;
+        out.reserve(countLines(first, last) * columns);
+        forEachLine(first, last, [&](const char* begin, const char* end) {
+            if (isBlank(begin, end)) return;
+            const size_t mark = out.size();
+            bool valid = true;
+            const size_t fields = forEachField(begin, end, [&](const char* fieldBegin, const char* fieldEnd) {
+                double value;
+                valid = valid && parseDoubleField(fieldBegin, fieldEnd, value);
+                out.push_back(valid ? value : 0.0);
+            });
+            if (!valid || fields != columns) {
+                out.resize(mark);
+                ++skipped;
+            }
+        });
+        return skipped;
+    }
+
+    void updateMetadata() {
+        setMetadata("rows", std::to_string(getSize()));
+        setMetadata("columns", std::to_string(columns_));
+        setMetadata("skipped_lines", std::to_string(skippedLines_));
+    }
+};
+
+// ѡͼе i жӦݼĵ (*this)[i] 
+// Ȳֻ±б shared_ptr ѡ񲻸±
+class RowSelection {
+public:
+    enum class Kind {
+        RANGE,      // [begin, begin + count)
+        STRIDED,    // begin, begin + step, ...  count 
+        INDEXED     // ±б
+    };
+
+private:
+    Kind kind_;
+    size_t begin_;
+    size_t step_;
+    size_t count_;
+    std::shared_ptr<const std::vector<size_t>> indices_;
+
+    RowSelection(Kind kind, size_t begin, size_t step, size_t count,
+                 std::shared_ptr<const std::vector<size_t>> indices = nullptr)
+        : kind_(kind), begin_(begin), step_(step), count_(count), indices_(std::move(indices)) {}
+
+public:
+    static RowSelection range(size_t begin, size_t end) {
+        return RowSelection(Kind::RANGE, begin, 1, end > begin ? end - begin : 0);
+    }
+
+    static RowSelection strided(size_t begin, size_t step, size_t count) {
+        if (step == 0) {
+            throw PlatformException("Row selection step must be positive");
+        }
+        // The last row and the extent past it must both be representable
+        size_t span = 0, last = 0;
+        if (count > 0 && (__builtin_mul_overflow(step, count - 1, &span) ||
+                          __builtin_add_overflow(begin, span, &last) || last == std::numeric_limits<size_t>::max())) {
+            throw PlatformException("Row selection out of range");
+        }
+        return RowSelection(step == 1 ? Kind::RANGE : Kind::STRIDED, begin, step, count);
+    }
+
+    static RowSelection indices(std::vector<size_t> rows) {
+        const size_t count = rows.size();
+        return RowSelection(Kind::INDEXED, 0, 1, count,
+                            std::make_shared<const std::vector<size_t>>(std::move(rows)));
+    }
+
+    Kind getKind() const { return kind_; }
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    bool isContiguous() const { return kind_ == Kind::RANGE; }
+    size_t getBegin() const { return begin_; }
+
+    size_t operator[](size_t i) const {
+        switch (kind_) {
+            case Kind::RANGE: return begin_ + i;
+            case Kind::STRIDED: return begin_ + i * step_;
+            default: return (*indices_)[i];
+        }
+    }
+
+    // ĸк + 1Խ
+    size_t getExtent() const {
+        if (count_ == 0) return 0;
+        if (kind_ != Kind::INDEXED) return (*this)[count_ - 1] + 1;
+        return *std::max_element(indices_->begin(), indices_->end()) + 1;
+    }
+
+    // Ȱ inner ѡѡеУĵ i  = (*this)[inner[i]]
+    RowSelection compose(const RowSelection& inner) const {
+        if (inner.count_ > 0 && inner.getExtent() > count_) {
+            throw PlatformException("Row selection out of range");
+        }
+        if (kind_ != Kind::INDEXED && inner.kind_ != Kind::INDEXED) {
+            size_t step = 1;
+            if (inner.count_ > 1 && __builtin_mul_overflow(step_, inner.step_, &step)) {
+                throw PlatformException("Row selection out of range");
+            }
+            return strided((*this)[inner.begin_], step, inner.count_);
+        }
+        std::vector<size_t> rows(inner.count_);
+        for (size_t i = 0; i < rows.size(); ++i) {
+            rows[i] = (*this)[inner[i]];
+        }
+        return indices(std::move(rows));
+    }
+
+    RowSelection slice(size_t begin, size_t end) const {
+        return compose(range(begin, std::min(end, count_)));
+    }
+};
+
+// ƣ㷨ݴ岢
+struct SampleDesign {
+    enum class Method {
+        BERNOULLI,      // ÿжԹ̶ѡ
+        RESERVOIR,      // ̶ļ
+        STRATIFIED      // ķֲ
+    };
+
+    Method method = Method::RESERVOIR;
+    size_t populationSize = 0;
+    // ֲ h λͼλ [strataOffsets[h], strataOffsets[h + 1])
+    // ò strataPopulation[h] УΪ
+    std::vector<size_t> strataOffsets;
+    std::vector<size_t> strataPopulation;
+
+    std::string getMethodName() const {
+        switch (method) {
+            case Method::BERNOULLI: return "bernoulli";
+            case Method::STRATIFIED: return "stratified";
+            default: return "reservoir";
+        }
+    }
+};
+
+// ݼͼ븸ݼݣֻ¼ѡеУ䡢Ȳ±б
+// ͼ̶ڴʱݼ汾Ŀϣ֮Ըݼ޸ĲӰͼ
+// ͼͼֱָͬһգͼֻload() / preprocess()  false
+class DatasetView : public IDataset {
+private:
+    std::shared_ptr<const IDataset> parent_;
+    RowSelection rows_;
+    std::shared_ptr<const SampleDesign> sample_;   // õͼ
+
+public:
+    static constexpr size_t GATHER_BLOCK = 1024;
+
+    // ͼͼԭ̳г
+    DatasetView(std::shared_ptr<const IDataset> parent, const RowSelection& rows,
+                std::shared_ptr<const SampleDesign> sample = nullptr)
+        : parent_(std::move(parent)), rows_(rows), sample_(std::move(sample)) {
+        if (!parent_) {
+            throw PlatformException("Dataset view requires a parent dataset");
+        }
+        if (auto view = std::dynamic_pointer_cast<const DatasetView>(parent_)) {
+            rows_ = view->rows_.compose(rows);
+            parent_ = view->parent_;
+            return;
+        }
+        if (auto baseDataset = std::dynamic_pointer_cast<const BaseDataset>(parent_)) {
+            if (auto pinned = baseDataset->snapshot()) parent_ = pinned;
+        }
+        if (rows_.getExtent() > parent_->getSize()) {
+            throw PlatformException("Row selection out of range");
+        }
+    }
+
+    bool load(const std::string& source) override {
+        (void)source;
+        return false;
+    }
+
+    bool validate() const override {
+        return !isEmpty() && parent_->validate();
+    }
+
+    bool preprocess() override {
+        return false;
+    }
+
+    std::string getType() const override {
+        return parent_->getType();
+    }
+
+    size_t getSize() const override {
+        return rows_.size();
+    }
+
+    std::string getDescription() const override {
+        return "View of " + std::to_string(rows_.size()) + " rows of " + parent_->getType() + " dataset";
+    }
+
+    bool isEmpty() const override {
+        return rows_.empty();
+    }
+
+    // ֻͼݼӰ
+    void clear() override {
+        rows_ = RowSelection::range(0, 0);
+        sample_.reset();
+    }
+
+    const std::shared_ptr<const IDataset>& getParent() const { return parent_; }
+    const RowSelection& getRows() const { return rows_; }
+    const SampleDesign* getSampleDesign() const { return sample_.get(); }
+
+    template<typename DatasetType>
+    std::shared_ptr<const DatasetType> getParentAs() const {
+        return std::dynamic_pointer_cast<const DatasetType>(parent_);
+    }
+
+    // ͼλ [begin, end)consumer(firstRow, rows, count)
+    // ֻصһ rows ΪգкΪ firstRow ... firstRow + count - 1㿽
+    // ÿ GATHER_BLOCK Уrows Щеĸк
+    template<typename Consumer>
+    void forEachRowBlock(size_t begin, size_t end, Consumer&& consumer) const {
+        end = std::min(end, rows_.size());
+        if (begin >= end) return;
+        if (rows_.isContiguous()) {
+            consumer(rows_[begin], static_cast<const size_t*>(nullptr), end - begin);
+            return;
+        }
+        size_t block[GATHER_BLOCK];
+        for (size_t i = begin; i < end; i += GATHER_BLOCK) {
+            const size_t n = std::min(GATHER_BLOCK, end - i);
+            for (size_t j = 0; j < n; ++j) block[j] = rows_[i + j];
+            consumer(size_t(0), static_cast<const size_t*>(block), n);
+        }
+    }
+
+    // ȡһбѡеֱֵӴڵָ룬ռС
+    template<typename T, typename Consumer>
+    void forEachValueBlock(const T* column, size_t begin, size_t end, Consumer&& consumer) const {
+        T gathered[GATHER_BLOCK];
+        forEachRowBlock(begin, end, [&](size_t first, const size_t* rows, size_t count) {
+            if (!rows) {
+                consumer(column + first, count);
+                return;
+            }
+            for (size_t j = 0; j < count; ++j) gathered[j] = column[rows[j]];
+            consumer(static_cast<const T*>(gathered), count);
+        });
+    }
+};
+
+// ݼͼıݺ
+inline std::shared_ptr<DatasetView> makeView(const std::shared_ptr<const IDataset>& dataset,
+                                             const RowSelection& rows) {
+    return std::make_shared<DatasetView>(dataset, rows);
+}
+
+// ӣǸݼϵ±ͼ±򣬷ֲΪ򣩣
+// ݣгƹ㷨
+
+// ŬηֲδѡУʱ
+inline std::shared_ptr<DatasetView> bernoulliSample(const std::shared_ptr<const IDataset>& dataset,
+                                                    double probability,
+                                                    uint64_t seed = std::mt19937_64::default_seed) {
+    if (!(probability > 0.0 && probability <= 1.0)) {
+        throw PlatformException("Sampling probability must be in (0, 1]");
+    }
+    const size_t population = dataset->getSize();
+    std::vector<size_t> rows;
+    rows.reserve(static_cast<size_t>(population * probability * 1.1) + 16);
+    if (probability == 1.0) {
+        for (size_t row = 0; row < population; ++row) rows.push_back(row);
+    } else {
+        std::mt19937_64 rng(seed);
+        std::geometric_distribution<size_t> skip(probability);
+        for (size_t row = skip(rng); row < population; row += skip(rng) + 1) {
+            rows.push_back(row);
+        }
+    }
+
+    auto design = std::make_shared<SampleDesign>();
+    design->method = SampleDesign::Method::BERNOULLI;
+    design->populationSize = population;
+    return std::make_shared<DatasetView>(dataset, RowSelection::indices(std::move(rows)), design);
+}
+
+namespace detail {
+
+// ˮسLi  Algorithm Lһɨ賤δ֪УֻڽҪ滻ʱų
+// ԼΪ k * (1 + log(n / k))offer(count) ύ count Ԫأ
+// һѡԪصλüˮеĲλ
+class ReservoirSampler {
+private:
+    size_t capacity_;
+    size_t seen_;
+    size_t next_;       // һѡԪصȫλ
+    double w_;
+    std::mt19937_64 rng_;
+    std::uniform_real_distribution<double> uniform_;
+
+public:
+    ReservoirSampler(size_t capacity, uint64_t seed)
+        : capacity_(capacity), seen_(0), next_(0), w_(1.0), rng_(seed), uniform_(0.0, 1.0) {
+        if (capacity_ > 0) {
+            w_ = std::exp(std::log(random()) / static_cast<double>(capacity_));
+            next_ = capacity_ - 1;
+            advance();
+        }
+    }
+
+    template<typename Accept>
+    void offer(size_t count, Accept&& accept) {
+        if (capacity_ == 0) {
+            seen_ += count;
+            return;
+        }
+        const size_t end = seen_ + count;
+        // The first capacity_ elements fill the reservoir in order
+        for (; seen_ < std::min(end, capacity_); ++seen_) {
+            accept(seen_ - (end - count), seen_);
+        }
+        while (next_ < end) {
+            const size_t slot = static_cast<size_t>(random() * static_cast<double>(capacity_)) % capacity_;
+            accept(next_ - (end - count), slot);
+            w_ *= std::exp(std::log(random()) / static_cast<double>(capacity_));
+            advance();
+        }
+        seen_ = end;
+    }
+
+    size_t getSeen() const { return seen_; }
+
+private:
+    double random() {
+        double u;
+        do { u = uniform_(rng_); } while (u <= 0.0);
+        return u;
+    }
+
+    void advance() {
+        const double gap = std::floor(std::log(random()) / std::log1p(-w_));
+        next_ += (gap < 9e18 ? static_cast<size_t>(gap) : size_t(9e18)) + 1;
+    }
+};
+
+} // namespace detail
+
+// ˮس̶ļ
+inline std::shared_ptr<DatasetView> reservoirSample(const std::shared_ptr<const IDataset>& dataset,
+                                                    size_t sampleSize,
+                                                    uint64_t seed = std::mt19937_64::default_seed) {
+    const size_t population = dataset->getSize();
+    std::vector<size_t> rows(std::min(sampleSize, population));
+    detail::ReservoirSampler sampler(rows.size(), seed);
+    sampler.offer(population, [&rows](size_t row, size_t slot) { rows[slot] = row; });
+    std::sort(rows.begin(), rows.end());
+
+    auto design = std::make_shared<SampleDesign>();
+    design->method = SampleDesign::Method::RESERVOIR;
+    design->populationSize = population;
+    return std::make_shared<DatasetView>(dataset, RowSelection::indices(std::move(rows)), design);
+}
+
+// ʽݼˮسһɨԴļֵµ NumericDataset У
+// ظȫеͼ
+inline std::shared_ptr<DatasetView> reservoirSample(const StreamingNumericDataset& dataset,
+                                                    size_t sampleSize,
+                                                    uint64_t seed = std::mt19937_64::default_seed) {
+    std::vector<double> reservoir;
+    reservoir.reserve(std::min(sampleSize, dataset.getSize()));
+    detail::ReservoirSampler sampler(sampleSize, seed);
+    dataset.forEachChunk([&](const double* values, size_t count) {
+        sampler.offer(count, [&](size_t index, size_t slot) {
+            if (slot < reservoir.size()) reservoir[slot] = values[index];
+            else reservoir.push_back(values[index]);
+        });
+    });
+
+    auto values = std::make_shared<NumericDataset>();
+    values->setProcessingOptions(dataset.getProcessingOptions());
+    values->setExecutor(&dataset.getExecutor());
+    values->append(reservoir);
+
+    auto design = std::make_shared<SampleDesign>();
+    design->method = SampleDesign::Method::RESERVOIR;
+    design->populationSize = sampler.getSeen();
+    return std::make_shared<DatasetView>(values, RowSelection::range(0, reservoir.size()), design);
+}
+
+// ֲstrata[row] ΪÿеĲţ䣨ǿղ 1 У
+// ڲСʱͬ¹ƵС
+inline std::shared_ptr<DatasetView> stratifiedSample(const std::shared_ptr<const IDataset>& dataset,
+                                                     const std::vector<uint32_t>& strata,
+                                                     size_t sampleSize,
+                                                     uint64_t seed = std::mt19937_64::default_seed) {
+    const size_t population = dataset->getSize();
+    if (strata.size() != population) {
+        throw PlatformException("Stratum labels must cover every row");
+    }
+    const size_t strataCount = strata.empty() ? 0 :
+        static_cast<size_t>(*std::max_element(strata.begin(), strata.end())) + 1;
+
+    // Rows grouped by stratum (counting sort keeps them ascending)
+    std::vector<size_t> offsets(strataCount + 1, 0);
+    for (uint32_t h : strata) ++offsets[h + 1];
+    for (size_t h = 0; h < strataCount; ++h) offsets[h + 1] += offsets[h];
+    std::vector<size_t> grouped(population);
+    {
+        std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t row = 0; row < population; ++row) grouped[cursor[strata[row]]++] = row;
+    }
+
+    auto design = std::make_shared<SampleDesign>();
+    design->method = SampleDesign::Method::STRATIFIED;
+    design->populationSize = population;
+    design->strataOffsets.push_back(0);
+
+    std::vector<size_t> rows;
+    rows.reserve(std::min(sampleSize + strataCount, population));
+    std::mt19937_64 rng(seed);
+    for (size_t h = 0; h < strataCount; ++h) {
+        const size_t stratumSize = offsets[h + 1] - offsets[h];
+        if (stratumSize == 0) continue;
+        const double share = static_cast<double>(sampleSize) * stratumSize / std::max<size_t>(population, 1);
+        const size_t take = std::min(stratumSize, std::max<size_t>(1, static_cast<size_t>(std::llround(share))));
+
+        const size_t first = rows.size();
+        detail::ReservoirSampler sampler(take, rng());
+        rows.resize(first + take);
+        sampler.offer(stratumSize, [&](size_t index, size_t slot) {
+            rows[first + slot] = grouped[offsets[h] + index];
+        });
+        std::sort(rows.begin() + first, rows.end());
+
+        design->strataOffsets.push_back(rows.size());
+        design->strataPopulation.push_back(stratumSize);
+    }
+    return std::make_shared<DatasetView>(dataset, RowSelection::indices(std::move(rows)), design);
+}
+
+// ֵķλзֳ strata 㣨Ƶֲ㣩ڶֵݼֲ
+inline std::vector<uint32_t> valueStrata(const NumericDataset& dataset, size_t strata) {
+    const auto& data = dataset.getData();
+    std::vector<uint32_t> labels(data.size(), 0);
+    if (strata <= 1 || data.empty()) return labels;
+
+    const size_t ordered = dataset.getOrderedCount();
+    if (ordered == 0) return labels;
+    std::vector<size_t> ranks;
+    for (size_t h = 1; h < strata; ++h) ranks.push_back(h * ordered / strata);
+    std::vector<double> bounds = dataset.getOrderStatistics(ranks);
+    bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+    for (size_t i = 0; i < data.size(); ++i) {
+        labels[i] = static_cast<uint32_t>(std::upper_bound(bounds.begin(), bounds.end(), data[i]) - bounds.begin());
+    }
+    return labels;
+}
+
+// ݼ
+class DatasetFactory {
+public:
+    static std::shared_ptr<IDataset> createDataset(const std::string& type) {
+        if (type == "NUMERIC") {
+            return std::make_shared<NumericDataset>();
+        }
+        else if (type == "TEXT") {
+            return std::make_shared<TextDataset>();
+        }
+        else if (type == "NUMERIC_STREAM") {
+            return std::make_shared<StreamingNumericDataset>();
+        }
+        else if (type == "TEXT_STREAM") {
+            return std::make_shared<StreamingTextDataset>();
+        }
+        else if (type == "TABLE") {
+            return std::make_shared<TableDataset>();
+        }
+        else if (type == "CATEGORICAL") {
+            return std::make_shared<CategoricalDataset>();
+        }
+        else if (type == "DATETIME") {
+            return std::make_shared<DateTimeDataset>();
+        }
+        else if (type == "MATRIX") {
+            return std::make_shared<MatrixDataset>();
         }
         throw PlatformException("Unknown dataset type: " + type);
     }
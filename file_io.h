@@ -0,0 +1,805 @@
+// file_io.h
+#ifndef FILE_IO_H
+#define FILE_IO_H
+
+#include "core_framework.h"
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cctype>
+#include <cstdint>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace DataPlatform {
+
+// ֻڴӳļ
+// ͨļֱ mmapܵ޷ӳ˻ΪһԶڲ
+class MappedFile {
+private:
+    int fd_;
+    const char* data_;
+    size_t size_;
+    bool mapped_;
+    std::string buffer_;
+
+public:
+    explicit MappedFile(const std::string& path)
+        : fd_(-1), data_(nullptr), size_(0), mapped_(false)
+    {
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            throw PlatformException("Failed to open file: " + path);
+        }
+
+        struct stat st;
+        if (::fstat(fd_, &st) == 0 && S_ISREG(st.st_mode)) {
+            size_ = static_cast<size_t>(st.st_size);
+            if (size_ == 0) {
+                return;
+            }
+            void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+            if (addr != MAP_FAILED) {
+                ::madvise(addr, size_, MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(addr);
+                mapped_ = true;
+                return;
+            }
+        }
+
+        // Fallback: read the whole stream into memory
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            throw PlatformException("Failed to open file: " + path);
+        }
+        std::ostringstream oss;
+        oss << file.rdbuf();
+        buffer_ = oss.str();
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+    }
+
+    ~MappedFile() {
+        if (mapped_) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    const char* begin() const { return data_; }
+    const char* end() const { return data_ + size_; }
+};
+
+// ͳƻе std::getline зַʽһ£
+inline size_t countLines(const char* first, const char* last) {
+    size_t lines = 0;
+    const char* p = first;
+    while (p < last) {
+        const void* nl = std::memchr(p, '\n', last - p);
+        ++lines;
+        if (!nl) break;
+        p = static_cast<const char*>(nl) + 1;
+    }
+    return lines;
+}
+
+//  [first, last) ͷĸֵ֮λãʧʱ nullptr
+inline const char* parseDoublePrefix(const char* first, const char* last, double& value) {
+    while (first < last && std::isspace(static_cast<unsigned char>(*first))) {
+        ++first;
+    }
+    if (first == last) return nullptr;
+
+    bool negative = false;
+    const char* p = first;
+    if (*p == '+' || *p == '-') {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    // Hexadecimal floats ("0x1.8p3"), accepted by strtod but not by from_chars
+    if (last - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+        auto res = std::from_chars(p + 2, last, value, std::chars_format::hex);
+        if (res.ec == std::errc()) {
+            if (negative) value = -value;
+            return res.ptr;
+        }
+        if (res.ec == std::errc::result_out_of_range) return nullptr;
+    }
+
+    // from_chars rejects a leading '+', and a second sign after it must not parse
+    if (*first == '+') {
+        if (p == last || *p == '-' || *p == '+') return nullptr;
+        first = p;
+    }
+
+    auto res = std::from_chars(first, last, value);
+    return res.ec == std::errc() ? res.ptr : nullptr;
+}
+
+// һ׳쳣
+//  std::stod һ£ǰհף '+' źʮƣֻҪǰ׺Ϸ
+inline bool parseDouble(const char* first, const char* last, double& value) {
+    return parseDoublePrefix(first, last, value) != nullptr;
+}
+
+// ϸ汾βհֶαһ"12abc""2024-01-01" Ϸ
+//  CSV ֶκͲֵ
+inline bool parseDoubleField(const char* first, const char* last, double& value) {
+    while (last > first && std::isspace(static_cast<unsigned char>(last[-1]))) {
+        --last;
+    }
+    const char* end = parseDoublePrefix(first, last, value);
+    return end != nullptr && end == last;
+}
+
+inline bool parseDoubleField(const std::string& field, double& value) {
+    return parseDoubleField(field.data(), field.data() + field.size(), value);
+}
+
+// нֵ׷ӵ outرķǷ
+inline size_t parseNumericLines(const char* first, const char* last,
+                                std::vector<double>& out) {
+    size_t skipped = 0;
+    const char* p = first;
+    while (p < last) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', last - p));
+        const char* lineEnd = nl ? nl : last;
+
+        double value;
+        if (parseDouble(p, lineEnd, value)) {
+            out.push_back(value);
+        } else {
+            ++skipped;
+        }
+
+        p = nl ? nl + 1 : last;
+    }
+    return skipped;
+}
+
+// лصззַʽ std::getline һ
+template<typename Callback>
+inline void forEachLine(const char* first, const char* last, Callback&& callback) {
+    const char* p = first;
+    while (p < last) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', last - p));
+        const char* lineEnd = nl ? nl : last;
+        callback(p, lineEnd);
+        p = nl ? nl + 1 : last;
+    }
+}
+
+// ռǿı
+inline void collectTextLines(const char* first, const char* last,
+                             std::vector<std::string>& out) {
+    const char* p = first;
+    while (p < last) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', last - p));
+        const char* lineEnd = nl ? nl : last;
+        if (lineEnd != p) {
+            out.emplace_back(p, lineEnd);
+        }
+        p = nl ? nl + 1 : last;
+    }
+}
+
+// еһֽ
+struct ByteRange {
+    const char* first;
+    const char* last;
+};
+
+// зΪ maxParts Σÿβ minBytesзֵ㶼ڻз֮
+// ÿζɣ˳νĽȫһ
+inline std::vector<ByteRange> splitAtLineBoundaries(const char* first, const char* last,
+                                                    size_t maxParts, size_t minBytes) {
+    std::vector<ByteRange> ranges;
+    size_t total = static_cast<size_t>(last - first);
+    size_t parts = std::max<size_t>(1, std::min(maxParts, total / std::max<size_t>(minBytes, 1)));
+    size_t step = total / parts;
+
+    const char* begin = first;
+    for (size_t i = 1; i < parts && begin < last; ++i) {
+        const char* target = first + i * step;
+        if (target <= begin) continue;
+        const char* nl = static_cast<const char*>(std::memchr(target, '\n', last - target));
+        if (!nl) break;
+        ranges.push_back({begin, nl + 1});
+        begin = nl + 1;
+    }
+    if (begin < last || ranges.empty()) {
+        ranges.push_back({begin, last});
+    }
+    return ranges;
+}
+
+// ˳ȡֽԴ
+class IByteSource {
+public:
+    virtual ~IByteSource() = default;
+
+    // Reads up to capacity bytes into dst; returns 0 at end of input
+    virtual size_t read(char* dst, size_t capacity) = 0;
+};
+
+//  read(2) ļֽԴ
+class FileByteSource : public IByteSource {
+private:
+    int fd_;
+
+public:
+    explicit FileByteSource(const std::string& path) : fd_(::open(path.c_str(), O_RDONLY)) {
+        if (fd_ < 0) {
+            throw PlatformException("Failed to open file: " + path);
+        }
+        ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+
+    ~FileByteSource() override {
+        ::close(fd_);
+    }
+
+    FileByteSource(const FileByteSource&) = delete;
+    FileByteSource& operator=(const FileByteSource&) = delete;
+
+    size_t read(char* dst, size_t capacity) override {
+        while (true) {
+            ssize_t n = ::read(fd_, dst, capacity);
+            if (n >= 0) return static_cast<size_t>(n);
+            if (errno != EINTR) {
+                throw PlatformException("Failed to read file: " + std::string(std::strerror(errno)));
+            }
+        }
+    }
+};
+
+// Ԥװ̨߳ǰȡ depth 飬̶ȡص
+class PrefetchingByteSource : public IByteSource {
+private:
+    std::unique_ptr<IByteSource> inner_;
+    size_t blockSize_;
+    size_t depth_;
+
+    std::deque<std::vector<char>> ready_;
+    std::vector<std::vector<char>> free_;
+    std::vector<char> current_;
+    size_t currentPos_;
+    bool finished_;
+    bool stopping_;
+    std::exception_ptr error_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::thread worker_;
+
+public:
+    PrefetchingByteSource(std::unique_ptr<IByteSource> inner, size_t blockSize, size_t depth)
+        : inner_(std::move(inner))
+        , blockSize_(std::max<size_t>(blockSize, 4096))
+        , depth_(std::max<size_t>(depth, 1))
+        , currentPos_(0)
+        , finished_(false)
+        , stopping_(false)
+    {
+        worker_ = std::thread(&PrefetchingByteSource::prefetch, this);
+    }
+
+    ~PrefetchingByteSource() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        changed_.notify_all();
+        worker_.join();
+    }
+
+    size_t read(char* dst, size_t capacity) override {
+        size_t copied = 0;
+        while (copied < capacity) {
+            if (currentPos_ == current_.size()) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (!current_.empty()) {
+                    free_.push_back(std::move(current_));
+                    current_.clear();
+                    changed_.notify_all();
+                }
+                currentPos_ = 0;
+                changed_.wait(lock, [this] { return !ready_.empty() || finished_; });
+                if (ready_.empty()) {
+                    if (error_) std::rethrow_exception(error_);
+                    break;
+                }
+                current_ = std::move(ready_.front());
+                ready_.pop_front();
+                changed_.notify_all();
+            }
+
+            size_t n = std::min(capacity - copied, current_.size() - currentPos_);
+            std::memcpy(dst + copied, current_.data() + currentPos_, n);
+            copied += n;
+            currentPos_ += n;
+        }
+        return copied;
+    }
+
+private:
+    void prefetch() {
+        while (true) {
+            std::vector<char> block;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                changed_.wait(lock, [this] { return stopping_ || ready_.size() < depth_; });
+                if (stopping_) return;
+                if (!free_.empty()) {
+                    block = std::move(free_.back());
+                    free_.pop_back();
+                }
+            }
+
+            block.resize(blockSize_);
+            size_t n = 0;
+            std::exception_ptr error;
+            try {
+                n = inner_->read(block.data(), block.size());
+            } catch (...) {
+                error = std::current_exception();
+            }
+            block.resize(n);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (n == 0 || error) {
+                error_ = error;
+                finished_ = true;
+                changed_.notify_all();
+                return;
+            }
+            ready_.push_back(std::move(block));
+            changed_.notify_all();
+        }
+    }
+};
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>) && __has_include(<sys/syscall.h>)
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define DATAPLATFORM_HAS_IO_URING 1
+#endif
+#endif
+#endif
+
+#ifdef DATAPLATFORM_HAS_IO_URING
+// io_uring ֽԴͬʱ depth ڷУļ˳򽻸
+// ֻ֧ͨļcreate() ں˻ɳ䲻֧ io_uring ʱؿָ
+class UringByteSource : public IByteSource {
+private:
+    struct Slot {
+        std::vector<char> buffer;
+        iovec iov;
+        uint64_t offset;     // file offset of buffer[0]
+        size_t length;       // bytes requested for this block
+        size_t filled;       // bytes completed so far
+        size_t consumed;     // bytes already handed to the reader
+        bool busy;           // a read for this slot is in flight
+    };
+
+    int fd_;
+    int ringFd_;
+    uint64_t fileSize_;
+    uint64_t nextOffset_;
+    size_t blockSize_;
+
+    void* sqRing_;
+    size_t sqRingBytes_;
+    void* cqRing_;
+    size_t cqRingBytes_;
+    io_uring_sqe* sqes_;
+    size_t sqesBytes_;
+    unsigned* sqTail_;
+    unsigned* sqMask_;
+    unsigned* sqArray_;
+    unsigned* cqHead_;
+    unsigned* cqTail_;
+    unsigned* cqMask_;
+    io_uring_cqe* cqes_;
+
+    std::vector<Slot> slots_;
+    std::deque<size_t> order_;   // slots in file order
+    unsigned pendingSubmit_;
+    size_t inFlight_;
+
+    UringByteSource()
+        : fd_(-1), ringFd_(-1), fileSize_(0), nextOffset_(0), blockSize_(0)
+        , sqRing_(MAP_FAILED), sqRingBytes_(0), cqRing_(MAP_FAILED), cqRingBytes_(0)
+        , sqes_(nullptr), sqesBytes_(0)
+        , sqTail_(nullptr), sqMask_(nullptr), sqArray_(nullptr)
+        , cqHead_(nullptr), cqTail_(nullptr), cqMask_(nullptr), cqes_(nullptr)
+        , pendingSubmit_(0), inFlight_(0) {}
+
+public:
+    static std::unique_ptr<UringByteSource> create(const std::string& path, size_t blockSize, size_t depth) {
+        std::unique_ptr<UringByteSource> source(new UringByteSource());
+        source->fd_ = ::open(path.c_str(), O_RDONLY);
+        if (source->fd_ < 0) {
+            throw PlatformException("Failed to open file: " + path);
+        }
+        struct stat st;
+        if (::fstat(source->fd_, &st) != 0 || !S_ISREG(st.st_mode)) {
+            return nullptr;
+        }
+        source->fileSize_ = static_cast<uint64_t>(st.st_size);
+        source->blockSize_ = std::max<size_t>(blockSize, 4096);
+        ::posix_fadvise(source->fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+        if (!source->setupRing(static_cast<unsigned>(std::max<size_t>(depth, 1)))) {
+            return nullptr;
+        }
+        source->slots_.resize(std::max<size_t>(depth, 1));
+        for (size_t i = 0; i < source->slots_.size(); ++i) {
+            source->startBlock(i);
+        }
+        source->flush();
+        return source;
+    }
+
+    ~UringByteSource() override {
+        // The kernel may still write into slot buffers; drain before freeing them
+        try {
+            flush();
+            while (inFlight_ > 0) {
+                reap(true);
+            }
+        } catch (...) {
+        }
+        if (sqes_) ::munmap(sqes_, sqesBytes_);
+        if (cqRing_ != MAP_FAILED && cqRing_ != sqRing_) ::munmap(cqRing_, cqRingBytes_);
+        if (sqRing_ != MAP_FAILED) ::munmap(sqRing_, sqRingBytes_);
+        if (ringFd_ >= 0) ::close(ringFd_);
+        if (fd_ >= 0) ::close(fd_);
+    }
+
+    UringByteSource(const UringByteSource&) = delete;
+    UringByteSource& operator=(const UringByteSource&) = delete;
+
+    size_t read(char* dst, size_t capacity) override {
+        size_t copied = 0;
+        while (copied < capacity && !order_.empty()) {
+            Slot& slot = slots_[order_.front()];
+            while (slot.busy) {
+                flush();
+                reap(true);
+            }
+
+            size_t n = std::min(capacity - copied, slot.filled - slot.consumed);
+            std::memcpy(dst + copied, slot.buffer.data() + slot.consumed, n);
+            copied += n;
+            slot.consumed += n;
+
+            if (slot.consumed == slot.filled) {
+                // Block fully handed out; reuse the slot for the next block
+                size_t index = order_.front();
+                order_.pop_front();
+                startBlock(index);
+                flush();
+            }
+        }
+        return copied;
+    }
+
+private:
+    static int setup(unsigned entries, io_uring_params* params) {
+        return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    static int enter(int ringFd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+        return static_cast<int>(::syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+    }
+
+    bool setupRing(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        ringFd_ = setup(entries, &params);
+        if (ringFd_ < 0) return false;
+
+        sqRingBytes_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingBytes_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMap) {
+            sqRingBytes_ = cqRingBytes_ = std::max(sqRingBytes_, cqRingBytes_);
+        }
+
+        sqRing_ = ::mmap(nullptr, sqRingBytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ringFd_, IORING_OFF_SQ_RING);
+        if (sqRing_ == MAP_FAILED) return false;
+        if (singleMap) {
+            cqRing_ = sqRing_;
+        } else {
+            cqRing_ = ::mmap(nullptr, cqRingBytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             ringFd_, IORING_OFF_CQ_RING);
+            if (cqRing_ == MAP_FAILED) return false;
+        }
+        sqesBytes_ = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, sqesBytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                            ringFd_, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) return false;
+        sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+        char* sq = static_cast<char*>(sqRing_);
+        char* cq = static_cast<char*>(cqRing_);
+        sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    void startBlock(size_t index) {
+        if (nextOffset_ >= fileSize_) return;
+        Slot& slot = slots_[index];
+        slot.buffer.resize(blockSize_);
+        slot.offset = nextOffset_;
+        slot.length = static_cast<size_t>(std::min<uint64_t>(blockSize_, fileSize_ - nextOffset_));
+        slot.filled = 0;
+        slot.consumed = 0;
+        nextOffset_ += slot.length;
+        order_.push_back(index);
+        queueRead(index);
+    }
+
+    // Queues a read for the unfilled remainder of a slot (handles short reads)
+    void queueRead(size_t index) {
+        Slot& slot = slots_[index];
+        slot.iov.iov_base = slot.buffer.data() + slot.filled;
+        slot.iov.iov_len = slot.length - slot.filled;
+
+        unsigned tail = *sqTail_;
+        unsigned sqIndex = tail & *sqMask_;
+        io_uring_sqe& sqe = sqes_[sqIndex];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READV;
+        sqe.fd = fd_;
+        sqe.addr = reinterpret_cast<uint64_t>(&slot.iov);
+        sqe.len = 1;
+        sqe.off = slot.offset + slot.filled;
+        sqe.user_data = index;
+        sqArray_[sqIndex] = sqIndex;
+        __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+
+        slot.busy = true;
+        ++pendingSubmit_;
+        ++inFlight_;
+    }
+
+    void flush() {
+        while (pendingSubmit_ > 0) {
+            int n = enter(ringFd_, pendingSubmit_, 0, 0);
+            if (n < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY) continue;
+                throw PlatformException("io_uring submit failed: " + std::string(std::strerror(errno)));
+            }
+            pendingSubmit_ -= static_cast<unsigned>(n);
+        }
+    }
+
+    // Processes every available completion; optionally blocks for at least one
+    void reap(bool wait) {
+        unsigned head = *cqHead_;
+        if (wait && head == __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE)) {
+            if (enter(ringFd_, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+                throw PlatformException("io_uring wait failed: " + std::string(std::strerror(errno)));
+            }
+        }
+
+        std::string error;
+        while (head != __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE)) {
+            const io_uring_cqe& cqe = cqes_[head & *cqMask_];
+            Slot& slot = slots_[static_cast<size_t>(cqe.user_data)];
+            int res = cqe.res;
+            ++head;
+            __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+            --inFlight_;
+            slot.busy = false;
+
+            if (res == -EINTR || res == -EAGAIN) {
+                queueRead(static_cast<size_t>(cqe.user_data));
+            } else if (res < 0) {
+                error = std::strerror(-res);
+            } else {
+                slot.filled += static_cast<size_t>(res);
+                if (res > 0 && slot.filled < slot.length) {
+                    queueRead(static_cast<size_t>(cqe.user_data));
+                } else if (res == 0) {
+                    // The file shrank while reading; stop issuing new blocks
+                    slot.length = slot.filled;
+                    nextOffset_ = fileSize_;
+                }
+            }
+        }
+        if (!error.empty()) {
+            throw PlatformException("Failed to read file: " + error);
+        }
+    }
+};
+#endif
+
+// ˳ȡļֽԴdepth ΪԤĿ0 ʾԤ
+// preferUring ʱʹ io_uring˻غ̨Ԥ߳
+inline std::unique_ptr<IByteSource> openSequentialSource(const std::string& path, size_t blockSize,
+                                                         size_t depth, bool preferUring) {
+#ifdef DATAPLATFORM_HAS_IO_URING
+    if (preferUring && depth > 0) {
+        if (auto source = UringByteSource::create(path, blockSize, depth)) {
+            return source;
+        }
+    }
+#else
+    (void)preferUring;
+#endif
+    std::unique_ptr<IByteSource> source(new FileByteSource(path));
+    if (depth > 0) {
+        source.reset(new PrefetchingByteSource(std::move(source), blockSize, depth));
+    }
+    return source;
+}
+
+// ȡУÿηصֻֽУһûнβз
+// ߽ضϵһ
+class LineChunkReader {
+private:
+    std::unique_ptr<IByteSource> source_;
+    size_t chunkBytes_;
+    std::vector<char> buffer_;
+    size_t carryBegin_;
+    size_t carryEnd_;
+    bool eof_;
+
+public:
+    LineChunkReader(std::unique_ptr<IByteSource> source, size_t chunkBytes)
+        : source_(std::move(source))
+        , chunkBytes_(std::max<size_t>(chunkBytes, 4096))
+        , carryBegin_(0)
+        , carryEnd_(0)
+        , eof_(false) {}
+
+    bool next(ByteRange& chunk) {
+        // Move the partial line left over from the previous chunk to the front
+        size_t filled = carryEnd_ - carryBegin_;
+        if (carryBegin_ > 0 && filled > 0) {
+            std::memmove(buffer_.data(), buffer_.data() + carryBegin_, filled);
+        }
+        carryBegin_ = carryEnd_ = 0;
+
+        size_t scanned = 0;
+        while (true) {
+            if (buffer_.size() < filled + chunkBytes_) {
+                buffer_.resize(filled + chunkBytes_);
+            }
+            while (!eof_ && filled < buffer_.size()) {
+                size_t n = source_->read(buffer_.data() + filled, buffer_.size() - filled);
+                if (n == 0) eof_ = true;
+                filled += n;
+            }
+            if (filled == 0) return false;
+
+            const char* base = buffer_.data();
+            const char* lastNewline = nullptr;
+            for (const char* p = base + filled; p > base + scanned; --p) {
+                if (p[-1] == '\n') {
+                    lastNewline = p - 1;
+                    break;
+                }
+            }
+
+            if (lastNewline || eof_) {
+                size_t end = lastNewline && !eof_ ? static_cast<size_t>(lastNewline - base) + 1 : filled;
+                chunk = ByteRange{base, base + end};
+                carryBegin_ = end;
+                carryEnd_ = filled;
+                return true;
+            }
+            // A single line longer than the chunk; keep reading
+            scanned = filled;
+        }
+    }
+};
+
+// Сֽд
+inline bool isLittleEndianHost() {
+    const uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+inline void storeLE64(unsigned char* dst, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        dst[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+inline uint64_t loadLE64(const unsigned char* src) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<uint64_t>(src[i]) << (8 * i);
+    }
+    return value;
+}
+
+inline void storeLE32(unsigned char* dst, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        dst[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+inline uint32_t loadLE32(const unsigned char* src) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(src[i]) << (8 * i);
+    }
+    return value;
+}
+
+inline uint64_t doubleBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline double bitsToDouble(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// 64 λУͣ·е FNV ϣ 8 ֽڶȡ
+inline uint64_t checksum64(const void* data, size_t size) {
+    const uint64_t prime = 0x100000001b3ULL;
+    uint64_t lanes[4] = {0xcbf29ce484222325ULL, 0x84222325cbf29ce4ULL,
+                         0x9e3779b97f4a7c15ULL, 0xc2b2ae3d27d4eb4fULL};
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    size_t blocks = size / 32;
+    for (size_t i = 0; i < blocks; ++i, p += 32) {
+        for (int lane = 0; lane < 4; ++lane) {
+            lanes[lane] = (lanes[lane] ^ loadLE64(p + 8 * lane)) * prime;
+        }
+    }
+
+    uint64_t hash = size;
+    for (int lane = 0; lane < 4; ++lane) {
+        hash = (hash ^ lanes[lane]) * prime;
+        hash ^= hash >> 29;
+    }
+    for (size_t rest = size % 32; rest > 0; --rest, ++p) {
+        hash = (hash ^ *p) * prime;
+    }
+    return hash ^ (hash >> 32);
+}
+
+} // namespace DataPlatform
+
+#endif // FILE_IO_H
\ No newline at end of file
@@ -0,0 +1,949 @@
+// numeric_kernels.h
+#ifndef NUMERIC_KERNELS_H
+#define NUMERIC_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <vector>
+#include <numeric>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define DATAPLATFORM_X86_SIMD 1
+#endif
+
+namespace DataPlatform {
+
+// ɺϲͳۼcount / mean / M2 / min / max
+// ϲʹ Chan ˵Ĳзʽֵ Welford 㷨һȶ
+struct StatisticsAccumulator {
+    size_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    double minValue = std::numeric_limits<double>::infinity();
+    double maxValue = -std::numeric_limits<double>::infinity();
+
+    // Welford update with a single value
+    void add(double value) {
+        ++count;
+        const double delta = value - mean;
+        mean += delta / static_cast<double>(count);
+        m2 += delta * (value - mean);
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+    }
+
+    void merge(const StatisticsAccumulator& other) {
+        if (other.count == 0) return;
+        if (count == 0) {
+            *this = other;
+            return;
+        }
+        const double total = static_cast<double>(count + other.count);
+        const double delta = other.mean - mean;
+        mean += delta * (static_cast<double>(other.count) / total);
+        m2 += other.m2 + delta * delta *
+            (static_cast<double>(count) * static_cast<double>(other.count) / total);
+        count += other.count;
+        minValue = std::min(minValue, other.minValue);
+        maxValue = std::max(maxValue, other.maxValue);
+    }
+
+    // Population variance, matching the platform's std_dev definition
+    double variance() const { return count > 0 ? m2 / count : 0.0; }
+    double stdDev() const { return std::sqrt(variance()); }
+    // Unbiased estimate of the population variance from a sample; NaN below two values
+    double sampleVariance() const {
+        return count > 1 ? m2 / (count - 1) : std::numeric_limits<double>::quiet_NaN();
+    }
+};
+
+// ֲ̬ 97.5% λ 95% 
+constexpr double Z_95 = 1.959963984540054;
+
+// ɼֵʱķУ
+// 鵽ʱΪ 0ֵʱ޷ƣ
+inline double meanEstimateVariance(const StatisticsAccumulator& sample, size_t population) {
+    if (population <= sample.count) return 0.0;
+    if (sample.count < 2) return std::numeric_limits<double>::infinity();
+    const double n = static_cast<double>(sample.count);
+    const double fpc = 1.0 - n / static_cast<double>(population);
+    return sample.sampleVariance() / n * fpc;
+}
+
+namespace detail {
+
+// ÿԪɨ裨͡ƽͣ L1 
+constexpr size_t STATS_BLOCK = 2048;
+
+// min/max skip NaN in every kernel (as StatisticsAccumulator::add does), so the
+// result does not depend on the CPU or on where a NaN sits in the block
+struct BlockStats {
+    double sum;
+    double m2;
+    double minValue;
+    double maxValue;
+};
+
+inline BlockStats blockStatsScalar(const double* p, size_t n) {
+    double s[4] = {0.0, 0.0, 0.0, 0.0};
+    double lo = std::numeric_limits<double>::infinity(), hi = -lo;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (int j = 0; j < 4; ++j) {
+            s[j] += p[i + j];
+            lo = std::min(lo, p[i + j]);
+            hi = std::max(hi, p[i + j]);
+        }
+    }
+    for (; i < n; ++i) {
+        s[0] += p[i];
+        lo = std::min(lo, p[i]);
+        hi = std::max(hi, p[i]);
+    }
+    const double sum = (s[0] + s[1]) + (s[2] + s[3]);
+    const double mean = sum / n;
+
+    double q[4] = {0.0, 0.0, 0.0, 0.0};
+    for (i = 0; i + 4 <= n; i += 4) {
+        for (int j = 0; j < 4; ++j) {
+            const double d = p[i + j] - mean;
+            q[j] += d * d;
+        }
+    }
+    for (; i < n; ++i) {
+        const double d = p[i] - mean;
+        q[0] += d * d;
+    }
+    return {sum, (q[0] + q[1]) + (q[2] + q[3]), lo, hi};
+}
+
+#ifdef DATAPLATFORM_X86_SIMD
+
+__attribute__((target("avx2")))
+inline double hsumAvx2(__m256d v) {
+    __m128d lo = _mm256_castpd256_pd128(v);
+    __m128d hi = _mm256_extractf128_pd(v, 1);
+    lo = _mm_add_pd(lo, hi);
+    return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+}
+
+__attribute__((target("avx2")))
+inline BlockStats blockStatsAvx2(const double* p, size_t n) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    __m256d lo = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    __m256d hi = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d a = _mm256_loadu_pd(p + i);
+        __m256d b = _mm256_loadu_pd(p + i + 4);
+        s0 = _mm256_add_pd(s0, a);
+        s1 = _mm256_add_pd(s1, b);
+        // MINPD/MAXPD return the second operand when either is NaN, so the
+        // accumulator goes second and a NaN input leaves it unchanged
+        lo = _mm256_min_pd(b, _mm256_min_pd(a, lo));
+        hi = _mm256_max_pd(b, _mm256_max_pd(a, hi));
+    }
+    double sum = hsumAvx2(_mm256_add_pd(s0, s1));
+    alignas(32) double l[4], h[4];
+    _mm256_store_pd(l, lo);
+    _mm256_store_pd(h, hi);
+    double minValue = std::min(std::min(l[0], l[1]), std::min(l[2], l[3]));
+    double maxValue = std::max(std::max(h[0], h[1]), std::max(h[2], h[3]));
+    for (; i < n; ++i) {
+        sum += p[i];
+        minValue = std::min(minValue, p[i]);
+        maxValue = std::max(maxValue, p[i]);
+    }
+
+    const double mean = sum / n;
+    const __m256d m = _mm256_set1_pd(mean);
+    __m256d q0 = _mm256_setzero_pd(), q1 = _mm256_setzero_pd();
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256d a = _mm256_sub_pd(_mm256_loadu_pd(p + i), m);
+        __m256d b = _mm256_sub_pd(_mm256_loadu_pd(p + i + 4), m);
+        q0 = _mm256_add_pd(q0, _mm256_mul_pd(a, a));
+        q1 = _mm256_add_pd(q1, _mm256_mul_pd(b, b));
+    }
+    double m2 = hsumAvx2(_mm256_add_pd(q0, q1));
+    for (; i < n; ++i) {
+        const double d = p[i] - mean;
+        m2 += d * d;
+    }
+    return {sum, m2, minValue, maxValue};
+}
+
+// GCC 12's unmasked AVX-512 min/max and _mm512_reduce_* helpers trip
+// -Wuninitialized, so the kernel uses masked forms and reduces through memory
+__attribute__((target("avx512f")))
+inline double hsumAvx512(__m512d v) {
+    alignas(64) double lanes[8];
+    _mm512_store_pd(lanes, v);
+    return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+           ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+}
+
+__attribute__((target("avx512f")))
+inline BlockStats blockStatsAvx512(const double* p, size_t n) {
+    __m512d s = _mm512_setzero_pd();
+    __m512d lo = _mm512_set1_pd(std::numeric_limits<double>::infinity());
+    __m512d hi = _mm512_set1_pd(-std::numeric_limits<double>::infinity());
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d a = _mm512_loadu_pd(p + i);
+        s = _mm512_add_pd(s, a);
+        // Accumulator second: a NaN lane keeps its previous extreme
+        lo = _mm512_mask_min_pd(lo, 0xFF, a, lo);
+        hi = _mm512_mask_max_pd(hi, 0xFF, a, hi);
+    }
+    double sum = hsumAvx512(s);
+    alignas(64) double l[8], h[8];
+    _mm512_store_pd(l, lo);
+    _mm512_store_pd(h, hi);
+    double minValue = *std::min_element(l, l + 8);
+    double maxValue = *std::max_element(h, h + 8);
+    for (; i < n; ++i) {
+        sum += p[i];
+        minValue = std::min(minValue, p[i]);
+        maxValue = std::max(maxValue, p[i]);
+    }
+
+    const double mean = sum / n;
+    const __m512d m = _mm512_set1_pd(mean);
+    __m512d q = _mm512_setzero_pd();
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m512d a = _mm512_sub_pd(_mm512_loadu_pd(p + i), m);
+        q = _mm512_fmadd_pd(a, a, q);
+    }
+    double m2 = hsumAvx512(q);
+    for (; i < n; ++i) {
+        const double d = p[i] - mean;
+        m2 += d * d;
+    }
+    return {sum, m2, minValue, maxValue};
+}
+
+#endif // DATAPLATFORM_X86_SIMD
+
+using BlockStatsKernel = BlockStats (*)(const double*, size_t);
+
+// ʱ CPU ѡںˣֻһ
+inline BlockStatsKernel selectBlockStatsKernel() {
+#ifdef DATAPLATFORM_X86_SIMD
+    static const BlockStatsKernel kernel = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return &blockStatsAvx512;
+        if (__builtin_cpu_supports("avx2")) return &blockStatsAvx2;
+        return &blockStatsScalar;
+    }();
+    return kernel;
+#else
+    return &blockStatsScalar;
+#endif
+}
+
+inline StatisticsAccumulator toAccumulator(const BlockStats& block, size_t n) {
+    StatisticsAccumulator acc;
+    acc.count = n;
+    acc.mean = block.sum / n;
+    acc.m2 = block.m2;
+    acc.minValue = block.minValue;
+    acc.maxValue = block.maxValue;
+    return acc;
+}
+
+} // namespace detail
+
+//  min / max / mean / variance
+// ݰ鴦 SIMD ƽ֮ͣ merge ϲ
+// ԴģҲۼӵľʧ
+inline StatisticsAccumulator computeStatistics(const double* data, size_t size) {
+    StatisticsAccumulator total;
+    const detail::BlockStatsKernel kernel = detail::selectBlockStatsKernel();
+    for (size_t offset = 0; offset < size; offset += detail::STATS_BLOCK) {
+        const size_t n = std::min(detail::STATS_BLOCK, size - offset);
+        total.merge(detail::toAccumulator(kernel(data + offset, n), n));
+    }
+    return total;
+}
+
+// ѡͳͬ±ȡֵֻ O(n) ʱ
+// positions Ϊ 0 ±꣬scratch ᱻţ±ӴС nth_element
+// ÿѡС±ֻǰм
+inline std::vector<double> selectOrderStatistics(std::vector<double>& scratch,
+                                                 std::vector<size_t> positions) {
+    std::vector<double> values(positions.size());
+    std::vector<size_t> order(positions.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(),
+        [&positions](size_t a, size_t b) { return positions[a] > positions[b]; });
+
+    auto end = scratch.end();
+    for (size_t idx : order) {
+        auto nth = scratch.begin() + positions[idx];
+        if (nth < end) {
+            std::nth_element(scratch.begin(), nth, end);
+            end = nth;
+        }
+        values[idx] = *nth;
+    }
+    return values;
+}
+
+// нڴµĴͳѡ޷ڴʽ
+// scan(consumer) Ҫȫݷֿ齻 consumer(const double*, size_t)
+// ÿһÿȵǰĺѡ仮ΪȿֱͼֻȵͰȹ
+// ͬһɨ裬żֵλȶȲݡֱͼÿͰֵռ
+// ѡֵ maxValuesInMemoryѡֵŵʱռ nth_element õȷ
+// NaN ranks ڷ NaN ֵеȣminValue/maxValue Чʱɨһ
+template<typename Scan>
+inline std::vector<double> selectOrderStatisticsStreaming(Scan&& scan, const std::vector<size_t>& ranks,
+                                                          double minValue, double maxValue,
+                                                          size_t maxValuesInMemory) {
+    // Histograms hold a count, a minimum and a maximum per bin for every rank
+    const size_t bins = std::max<size_t>(2, std::min<size_t>(4096,
+        maxValuesInMemory / (3 * std::max<size_t>(ranks.size(), 1))));
+
+    // Each refinement level keeps the values that fell into one bin; a value is
+    // a candidate only if it matches every level, so rounding at bin edges
+    // cannot move values between levels
+    struct Level {
+        double low;
+        double scale;
+        size_t bin;
+    };
+    struct Target {
+        std::vector<Level> levels;
+        size_t rank;          // rank among the current candidates
+        size_t candidates;
+        double low;
+        double high;
+        bool done;
+        double value;
+        std::vector<size_t> histogram;
+        std::vector<double> binMin;
+        std::vector<double> binMax;
+        std::vector<double> values;
+    };
+    auto binOf = [bins](const Level& level, double x) {
+        double position = (x - level.low) * level.scale;
+        if (!(position > 0.0)) return size_t(0);
+        return std::min(bins - 1, static_cast<size_t>(position));
+    };
+    auto isCandidate = [&](const Target& target, double x) {
+        for (const Level& level : target.levels) {
+            if (binOf(level, x) != level.bin) return false;
+        }
+        return true;
+    };
+
+    if (!(minValue <= maxValue)) {
+        minValue = std::numeric_limits<double>::infinity();
+        maxValue = -std::numeric_limits<double>::infinity();
+        scan([&](const double* data, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                if (std::isnan(data[i])) continue;
+                minValue = std::min(minValue, data[i]);
+                maxValue = std::max(maxValue, data[i]);
+            }
+        });
+    }
+
+    std::vector<Target> targets(ranks.size());
+    for (size_t t = 0; t < ranks.size(); ++t) {
+        targets[t].rank = ranks[t];
+        targets[t].candidates = std::numeric_limits<size_t>::max();
+        targets[t].low = minValue;
+        targets[t].high = maxValue;
+        targets[t].done = false;
+        targets[t].value = 0.0;
+    }
+
+    while (true) {
+        std::vector<Target*> pending;
+        size_t candidates = 0;
+        for (Target& target : targets) {
+            if (target.done) continue;
+            if (target.low == target.high) {
+                target.done = true;
+                target.value = target.low;
+                continue;
+            }
+            pending.push_back(&target);
+            candidates += std::min(target.candidates, maxValuesInMemory + 1);
+        }
+        if (pending.empty()) break;
+
+        // Collecting keeps one copy of the candidates per pending rank
+        const bool collect = candidates <= maxValuesInMemory;
+        std::vector<Level> nextLevels(pending.size());
+        for (size_t t = 0; t < pending.size(); ++t) {
+            Target& target = *pending[t];
+            if (collect) {
+                std::vector<size_t>().swap(target.histogram);
+                std::vector<double>().swap(target.binMin);
+                std::vector<double>().swap(target.binMax);
+                target.values.reserve(target.candidates);
+            } else {
+                nextLevels[t] = Level{target.low, static_cast<double>(bins) / (target.high - target.low), 0};
+                target.histogram.assign(bins, 0);
+                target.binMin.assign(bins, std::numeric_limits<double>::infinity());
+                target.binMax.assign(bins, -std::numeric_limits<double>::infinity());
+            }
+        }
+
+        scan([&](const double* data, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                const double x = data[i];
+                if (std::isnan(x)) continue;
+                for (size_t t = 0; t < pending.size(); ++t) {
+                    Target& target = *pending[t];
+                    if (!isCandidate(target, x)) continue;
+                    if (collect) {
+                        target.values.push_back(x);
+                        continue;
+                    }
+                    const size_t bin = binOf(nextLevels[t], x);
+                    ++target.histogram[bin];
+                    target.binMin[bin] = std::min(target.binMin[bin], x);
+                    target.binMax[bin] = std::max(target.binMax[bin], x);
+                }
+            }
+        });
+
+        for (size_t t = 0; t < pending.size(); ++t) {
+            Target& target = *pending[t];
+            if (collect) {
+                std::nth_element(target.values.begin(), target.values.begin() + target.rank, target.values.end());
+                target.value = target.values[target.rank];
+                target.done = true;
+                std::vector<double>().swap(target.values);
+                continue;
+            }
+            size_t bin = 0;
+            while (target.rank >= target.histogram[bin]) {
+                target.rank -= target.histogram[bin];
+                ++bin;
+            }
+            nextLevels[t].bin = bin;
+            target.levels.push_back(nextLevels[t]);
+            target.candidates = target.histogram[bin];
+            target.low = target.binMin[bin];
+            target.high = target.binMax[bin];
+        }
+    }
+
+    std::vector<double> values(targets.size());
+    for (size_t t = 0; t < targets.size(); ++t) values[t] = targets[t].value;
+    return values;
+}
+
+// ԪزԤˮںִ
+struct ElementOp {
+    enum class Kind {
+        AFFINE,      // x * a + b
+        CLIP,        // clamp to [a, b]
+        LOG,         // natural log
+        DROP_NAN,    // remove NaN values
+        KEEP_RANGE   // remove values outside [a, b]; NaN is kept
+    };
+
+    Kind kind;
+    double a;
+    double b;
+};
+
+// һαִ ops͵ѹݣͬʱݵͳ
+// ݰ鿽ջϻڻִУÿѭ
+// ˮ߶ֻдһ
+inline StatisticsAccumulator applyElementwise(std::vector<double>& data,
+                                              const std::vector<ElementOp>& ops) {
+    StatisticsAccumulator total;
+    const detail::BlockStatsKernel kernel = detail::selectBlockStatsKernel();
+    double buffer[detail::STATS_BLOCK];
+    size_t write = 0;
+
+    for (size_t offset = 0; offset < data.size(); offset += detail::STATS_BLOCK) {
+        size_t n = std::min(detail::STATS_BLOCK, data.size() - offset);
+        std::copy(data.begin() + offset, data.begin() + offset + n, buffer);
+
+        for (const ElementOp& op : ops) {
+            switch (op.kind) {
+                case ElementOp::Kind::AFFINE:
+                    for (size_t i = 0; i < n; ++i) buffer[i] = buffer[i] * op.a + op.b;
+                    break;
+                case ElementOp::Kind::CLIP:
+                    for (size_t i = 0; i < n; ++i) buffer[i] = std::min(std::max(buffer[i], op.a), op.b);
+                    break;
+                case ElementOp::Kind::LOG:
+                    for (size_t i = 0; i < n; ++i) buffer[i] = std::log(buffer[i]);
+                    break;
+                case ElementOp::Kind::DROP_NAN: {
+                    size_t kept = 0;
+                    for (size_t i = 0; i < n; ++i) {
+                        buffer[kept] = buffer[i];
+                        kept += std::isnan(buffer[i]) ? 0 : 1;
+                    }
+                    n = kept;
+                    break;
+                }
+                case ElementOp::Kind::KEEP_RANGE: {
+                    size_t kept = 0;
+                    for (size_t i = 0; i < n; ++i) {
+                        const double x = buffer[i];
+                        buffer[kept] = x;
+                        kept += (x < op.a || x > op.b) ? 0 : 1;
+                    }
+                    n = kept;
+                    break;
+                }
+            }
+        }
+
+        if (n == 0) continue;
+        total.merge(detail::toAccumulator(kernel(buffer, n), n));
+        std::copy(buffer, buffer + n, data.begin() + write);
+        write += n;
+    }
+    data.resize(write);
+    return total;
+}
+
+// ݵĶͳѡcount ֵܷŽ maxValuesInMemory ʱ
+// һռ selectOrderStatisticsнڴѡ
+//  selectOrderStatisticsStreaming ͬNaN positions ڷ NaN ֵе
+template<typename Scan>
+inline std::vector<double> selectOrderStatisticsBounded(Scan&& scan, size_t count,
+                                                        const std::vector<size_t>& positions,
+                                                        double minValue, double maxValue,
+                                                        size_t maxValuesInMemory) {
+    if (count <= maxValuesInMemory) {
+        std::vector<double> scratch;
+        scratch.reserve(count);
+        scan([&scratch](const double* data, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                if (!std::isnan(data[i])) scratch.push_back(data[i]);
+            }
+        });
+        return selectOrderStatistics(scratch, positions);
+    }
+    return selectOrderStatisticsStreaming(scan, positions, minValue, maxValue, maxValuesInMemory);
+}
+
+// ۺϵĽԱΪ±꣬ҪϣַȽ
+struct GroupAggregates {
+    std::vector<uint64_t> counts;         // rows in the group
+    std::vector<uint64_t> valueCounts;    // rows with a value; empty when only counting
+    std::vector<double> sums;             // ֻʱΪ
+
+    GroupAggregates() = default;
+    GroupAggregates(size_t groups, bool withSums)
+        : counts(groups, 0), valueCounts(withSums ? groups : 0, 0), sums(withSums ? groups : 0, 0.0) {}
+
+    size_t size() const { return counts.size(); }
+
+    void merge(const GroupAggregates& other) {
+        for (size_t g = 0; g < counts.size(); ++g) counts[g] += other.counts[g];
+        for (size_t g = 0; g < valueCounts.size(); ++g) valueCounts[g] += other.valueCounts[g];
+        for (size_t g = 0; g < sums.size(); ++g) sums[g] += other.sums[g];
+    }
+};
+
+//  codes[i] values[i]ۼӵ outСڷı루ȱʧֵԣ
+// values ǿʱͬʱͣcounts ֵΪ NaN ֻ valueCounts  sums
+//  SQL  COUNT(*)COUNT(v)SUM(v) һ£
+inline void accumulateGroups(const uint32_t* codes, const double* values, size_t count,
+                             GroupAggregates& out) {
+    const size_t groups = out.counts.size();
+    if (values) {
+        uint64_t* counts = out.counts.data();
+        uint64_t* valueCounts = out.valueCounts.data();
+        double* sums = out.sums.data();
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t code = codes[i];
+            if (code >= groups) continue;
+            ++counts[code];
+            if (!std::isnan(values[i])) {
+                ++valueCounts[code];
+                sums[code] += values[i];
+            }
+        }
+        return;
+    }
+
+    // Runs of the same code would serialize on one counter; four interleaved
+    // sub-histograms keep consecutive increments independent. With many groups
+    // the counters rarely collide and the extra memory would only cost cache
+    constexpr size_t LANES = 4;
+    if (groups > 65536) {
+        for (size_t i = 0; i < count; ++i) {
+            if (codes[i] < groups) ++out.counts[codes[i]];
+        }
+        return;
+    }
+    std::vector<uint64_t> lanes(groups * LANES, 0);
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            const uint32_t code = codes[i + lane];
+            if (code < groups) ++lanes[code * LANES + lane];
+        }
+    }
+    for (; i < count; ++i) {
+        if (codes[i] < groups) ++lanes[codes[i] * LANES];
+    }
+    for (size_t g = 0; g < groups; ++g) {
+        out.counts[g] += lanes[g * LANES] + lanes[g * LANES + 1] + lanes[g * LANES + 2] + lanes[g * LANES + 3];
+    }
+}
+
+// һά k-means ķ䲽裺ÿģͬȡ±Сߣ
+// ͬʱۼӺlabels ͵ظ£Ƿе㻻˴
+using AssignNearestKernel = bool (*)(const double* data, size_t n, const double* centroids, size_t k,
+                                     int* labels, double* sums, uint64_t* counts);
+
+namespace detail {
+
+inline bool assignNearestScalar(const double* data, size_t n, const double* centroids, size_t k,
+                                int* labels, double* sums, uint64_t* counts) {
+    bool changed = false;
+    for (size_t i = 0; i < n; ++i) {
+        int nearest = 0;
+        double best = std::abs(data[i] - centroids[0]);
+        for (size_t j = 1; j < k; ++j) {
+            const double distance = std::abs(data[i] - centroids[j]);
+            if (distance < best) {
+                best = distance;
+                nearest = static_cast<int>(j);
+            }
+        }
+        changed |= labels[i] != nearest;
+        labels[i] = nearest;
+        sums[nearest] += data[i];
+        ++counts[nearest];
+    }
+    return changed;
+}
+
+#ifdef DATAPLATFORM_X86_SIMD
+
+// Eight points per step, as two independent chains, against every centroid;
+// same strict comparison as the scalar kernel, so the labels are identical
+__attribute__((target("avx2")))
+inline bool assignNearestAvx2(const double* data, size_t n, const double* centroids, size_t k,
+                              int* labels, double* sums, uint64_t* counts) {
+    const __m256d signBit = _mm256_set1_pd(-0.0);
+    __m128i same = _mm_set1_epi32(-1);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256d x0 = _mm256_loadu_pd(data + i);
+        const __m256d x1 = _mm256_loadu_pd(data + i + 4);
+        const __m256d c0 = _mm256_set1_pd(centroids[0]);
+        __m256d best0 = _mm256_andnot_pd(signBit, _mm256_sub_pd(x0, c0));
+        __m256d best1 = _mm256_andnot_pd(signBit, _mm256_sub_pd(x1, c0));
+        __m256d index0 = _mm256_setzero_pd();
+        __m256d index1 = _mm256_setzero_pd();
+        for (size_t j = 1; j < k; ++j) {
+            const __m256d c = _mm256_set1_pd(centroids[j]);
+            const __m256d label = _mm256_set1_pd(static_cast<double>(j));
+            const __m256d d0 = _mm256_andnot_pd(signBit, _mm256_sub_pd(x0, c));
+            const __m256d d1 = _mm256_andnot_pd(signBit, _mm256_sub_pd(x1, c));
+            const __m256d closer0 = _mm256_cmp_pd(d0, best0, _CMP_LT_OQ);
+            const __m256d closer1 = _mm256_cmp_pd(d1, best1, _CMP_LT_OQ);
+            best0 = _mm256_blendv_pd(best0, d0, closer0);
+            best1 = _mm256_blendv_pd(best1, d1, closer1);
+            index0 = _mm256_blendv_pd(index0, label, closer0);
+            index1 = _mm256_blendv_pd(index1, label, closer1);
+        }
+        const __m128i nearest0 = _mm256_cvtpd_epi32(index0);
+        const __m128i nearest1 = _mm256_cvtpd_epi32(index1);
+        __m128i* out = reinterpret_cast<__m128i*>(labels + i);
+        same = _mm_and_si128(same, _mm_cmpeq_epi32(nearest0, _mm_loadu_si128(out)));
+        same = _mm_and_si128(same, _mm_cmpeq_epi32(nearest1, _mm_loadu_si128(out + 1)));
+        _mm_storeu_si128(out, nearest0);
+        _mm_storeu_si128(out + 1, nearest1);
+        for (size_t lane = 0; lane < 8; ++lane) {
+            sums[labels[i + lane]] += data[i + lane];
+            ++counts[labels[i + lane]];
+        }
+    }
+    const bool changed = _mm_movemask_epi8(same) != 0xFFFF;
+    return assignNearestScalar(data + i, n - i, centroids, k, labels + i, sums, counts) || changed;
+}
+
+#endif // DATAPLATFORM_X86_SIMD
+
+} // namespace detail
+
+inline AssignNearestKernel selectAssignNearestKernel() {
+#ifdef DATAPLATFORM_X86_SIMD
+    static const AssignNearestKernel kernel = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? &detail::assignNearestAvx2 : &detail::assignNearestScalar;
+    }();
+    return kernel;
+#else
+    return &detail::assignNearestScalar;
+#endif
+}
+
+// ϵһά k-means 䣺İֵÿһ䣬
+// ֮ķֽöֲȷһηֻ O(k log n)
+// ɰõǰ׺ƴҪۼӡ
+// Ƚȫֻͬǡȵļܲͬ
+class SortedAssignment1D {
+public:
+    struct Segment {
+        size_t begin;
+        size_t end;
+        int cluster;
+
+        bool operator==(const Segment& other) const {
+            return begin == other.begin && end == other.end && cluster == other.cluster;
+        }
+    };
+
+private:
+    static constexpr size_t BLOCK = 4096;
+
+    const double* data_;
+    size_t size_;
+    std::vector<double> blockPrefix_;   // sum of all whole blocks before block b
+    std::vector<Segment> segments_;
+    std::vector<Segment> next_;
+    std::vector<int> order_;
+
+public:
+    // sorted Ҳ NaNʼʱе㶼ڴ 0
+    SortedAssignment1D(const double* sorted, size_t size)
+        : data_(sorted), size_(size), blockPrefix_(size / BLOCK + 1, 0.0) {
+        for (size_t b = 0; b < size / BLOCK; ++b) {
+            blockPrefix_[b + 1] = blockPrefix_[b] + sum(b * BLOCK, (b + 1) * BLOCK);
+        }
+        segments_.push_back({0, size, 0});
+    }
+
+    // µ»֣Ƿе㻻˴
+    bool assign(const double* centroids, size_t k) {
+        order_.resize(k);
+        std::iota(order_.begin(), order_.end(), 0);
+        std::sort(order_.begin(), order_.end(), [centroids](int a, int b) {
+            return centroids[a] < centroids[b] || (centroids[a] == centroids[b] && a < b);
+        });
+
+        next_.clear();
+        size_t begin = 0;
+        int current = order_[0];
+        for (size_t r = 1; r < k; ++r) {
+            const int candidate = order_[r];
+            const double a = centroids[current];
+            const double b = centroids[candidate];
+            // An equal centroid with a higher index never wins a point
+            if (a == b) continue;
+            const bool currentWinsTies = current < candidate;
+            const size_t end = static_cast<size_t>(std::partition_point(data_ + begin, data_ + size_,
+                [a, b, currentWinsTies](double x) {
+                    const double da = std::abs(x - a);
+                    const double db = std::abs(x - b);
+                    return da < db || (da == db && currentWinsTies);
+                }) - data_);
+            if (end > begin) next_.push_back({begin, end, current});
+            begin = end;
+            current = candidate;
+        }
+        if (size_ > begin) next_.push_back({begin, size_, current});
+
+        const bool changed = next_ != segments_;
+        segments_.swap(next_);
+        return changed;
+    }
+
+    // ÿصĺӵ sums / counts
+    void accumulate(double* sums, uint64_t* counts) const {
+        for (const Segment& segment : segments_) {
+            sums[segment.cluster] += rangeSum(segment.begin, segment.end);
+            counts[segment.cluster] += segment.end - segment.begin;
+        }
+    }
+
+    const std::vector<Segment>& getSegments() const { return segments_; }
+
+private:
+    double sum(size_t begin, size_t end) const {
+        double s[4] = {0.0, 0.0, 0.0, 0.0};
+        size_t i = begin;
+        for (; i + 4 <= end; i += 4) {
+            for (int j = 0; j < 4; ++j) s[j] += data_[i + j];
+        }
+        for (; i < end; ++i) s[0] += data_[i];
+        return (s[0] + s[1]) + (s[2] + s[3]);
+    }
+
+    double rangeSum(size_t begin, size_t end) const {
+        const size_t first = (begin + BLOCK - 1) / BLOCK;
+        const size_t last = end / BLOCK;
+        if (first >= last) return sum(begin, end);
+        return sum(begin, first * BLOCK) + (blockPrefix_[last] - blockPrefix_[first]) +
+               sum(last * BLOCK, end);
+    }
+};
+
+// ά k-means ķ䲽裬 [begin, end) 㡣㰴УSoAţ
+// columns[j][i] ǵ i ĵ j άcentroids дţk  d
+// ÿƽŷϾģͬȡ±Сߣͬʱۼ
+// ά֮ͣsums Ϊ k  dlabels ͵ظ£Ƿе㻻˴
+using AssignNearestNdKernel = bool (*)(const double* const* columns, size_t d, size_t begin, size_t end,
+                                       const double* centroids, size_t k,
+                                       int* labels, double* sums, uint64_t* counts);
+
+namespace detail {
+
+inline void accumulatePoint(const double* const* columns, size_t d, size_t i, int label,
+                            double* sums, uint64_t* counts) {
+    double* sum = sums + static_cast<size_t>(label) * d;
+    for (size_t j = 0; j < d; ++j) {
+        sum[j] += columns[j][i];
+    }
+    ++counts[label];
+}
+
+inline bool assignNearestNdScalar(const double* const* columns, size_t d, size_t begin, size_t end,
+                                  const double* centroids, size_t k,
+                                  int* labels, double* sums, uint64_t* counts) {
+    bool changed = false;
+    for (size_t i = begin; i < end; ++i) {
+        int nearest = 0;
+        double best = std::numeric_limits<double>::infinity();
+        for (size_t c = 0; c < k; ++c) {
+            const double* centroid = centroids + c * d;
+            double distance = 0.0;
+            for (size_t j = 0; j < d; ++j) {
+                const double diff = columns[j][i] - centroid[j];
+                distance += diff * diff;
+            }
+            if (distance < best) {
+                best = distance;
+                nearest = static_cast<int>(c);
+            }
+        }
+        changed |= labels[i] != nearest;
+        labels[i] = nearest;
+        accumulatePoint(columns, d, i, nearest, sums, counts);
+    }
+    return changed;
+}
+
+#ifdef DATAPLATFORM_X86_SIMD
+
+// Tiles of 8 points  4 centroids: the points' values for one dimension are
+// loaded once and reused against every centroid of the tile, and the point
+// block stays in L1 while it is compared with all centroid tiles. Distances
+// add up dimension by dimension without FMA, exactly like the scalar kernel
+__attribute__((target("avx2")))
+inline bool assignNearestNdAvx2(const double* const* columns, size_t d, size_t begin, size_t end,
+                                const double* centroids, size_t k,
+                                int* labels, double* sums, uint64_t* counts) {
+    const __m256d infinity = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    __m128i same = _mm_set1_epi32(-1);
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256d best0 = infinity, best1 = infinity;
+        __m256d index0 = _mm256_setzero_pd(), index1 = _mm256_setzero_pd();
+        size_t c = 0;
+        for (; c + 4 <= k; c += 4) {
+            const double* centroid = centroids + c * d;
+            __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+            __m256d b0 = _mm256_setzero_pd(), b1 = _mm256_setzero_pd();
+            __m256d e0 = _mm256_setzero_pd(), e1 = _mm256_setzero_pd();
+            __m256d f0 = _mm256_setzero_pd(), f1 = _mm256_setzero_pd();
+            for (size_t j = 0; j < d; ++j) {
+                const __m256d x0 = _mm256_loadu_pd(columns[j] + i);
+                const __m256d x1 = _mm256_loadu_pd(columns[j] + i + 4);
+                __m256d m = _mm256_set1_pd(centroid[j]);
+                __m256d u = _mm256_sub_pd(x0, m), v = _mm256_sub_pd(x1, m);
+                a0 = _mm256_add_pd(a0, _mm256_mul_pd(u, u));
+                a1 = _mm256_add_pd(a1, _mm256_mul_pd(v, v));
+                m = _mm256_set1_pd(centroid[d + j]);
+                u = _mm256_sub_pd(x0, m);
+                v = _mm256_sub_pd(x1, m);
+                b0 = _mm256_add_pd(b0, _mm256_mul_pd(u, u));
+                b1 = _mm256_add_pd(b1, _mm256_mul_pd(v, v));
+                m = _mm256_set1_pd(centroid[2 * d + j]);
+                u = _mm256_sub_pd(x0, m);
+                v = _mm256_sub_pd(x1, m);
+                e0 = _mm256_add_pd(e0, _mm256_mul_pd(u, u));
+                e1 = _mm256_add_pd(e1, _mm256_mul_pd(v, v));
+                m = _mm256_set1_pd(centroid[3 * d + j]);
+                u = _mm256_sub_pd(x0, m);
+                v = _mm256_sub_pd(x1, m);
+                f0 = _mm256_add_pd(f0, _mm256_mul_pd(u, u));
+                f1 = _mm256_add_pd(f1, _mm256_mul_pd(v, v));
+            }
+            const __m256d distances0[4] = {a0, b0, e0, f0};
+            const __m256d distances1[4] = {a1, b1, e1, f1};
+            for (size_t t = 0; t < 4; ++t) {
+                const __m256d label = _mm256_set1_pd(static_cast<double>(c + t));
+                const __m256d closer0 = _mm256_cmp_pd(distances0[t], best0, _CMP_LT_OQ);
+                const __m256d closer1 = _mm256_cmp_pd(distances1[t], best1, _CMP_LT_OQ);
+                best0 = _mm256_blendv_pd(best0, distances0[t], closer0);
+                best1 = _mm256_blendv_pd(best1, distances1[t], closer1);
+                index0 = _mm256_blendv_pd(index0, label, closer0);
+                index1 = _mm256_blendv_pd(index1, label, closer1);
+            }
+        }
+        for (; c < k; ++c) {
+            const double* centroid = centroids + c * d;
+            __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+            for (size_t j = 0; j < d; ++j) {
+                const __m256d m = _mm256_set1_pd(centroid[j]);
+                const __m256d u = _mm256_sub_pd(_mm256_loadu_pd(columns[j] + i), m);
+                const __m256d v = _mm256_sub_pd(_mm256_loadu_pd(columns[j] + i + 4), m);
+                a0 = _mm256_add_pd(a0, _mm256_mul_pd(u, u));
+                a1 = _mm256_add_pd(a1, _mm256_mul_pd(v, v));
+            }
+            const __m256d label = _mm256_set1_pd(static_cast<double>(c));
+            const __m256d closer0 = _mm256_cmp_pd(a0, best0, _CMP_LT_OQ);
+            const __m256d closer1 = _mm256_cmp_pd(a1, best1, _CMP_LT_OQ);
+            best0 = _mm256_blendv_pd(best0, a0, closer0);
+            best1 = _mm256_blendv_pd(best1, a1, closer1);
+            index0 = _mm256_blendv_pd(index0, label, closer0);
+            index1 = _mm256_blendv_pd(index1, label, closer1);
+        }
+
+        const __m128i nearest0 = _mm256_cvtpd_epi32(index0);
+        const __m128i nearest1 = _mm256_cvtpd_epi32(index1);
+        __m128i* out = reinterpret_cast<__m128i*>(labels + i);
+        same = _mm_and_si128(same, _mm_cmpeq_epi32(nearest0, _mm_loadu_si128(out)));
+        same = _mm_and_si128(same, _mm_cmpeq_epi32(nearest1, _mm_loadu_si128(out + 1)));
+        _mm_storeu_si128(out, nearest0);
+        _mm_storeu_si128(out + 1, nearest1);
+        for (size_t lane = 0; lane < 8; ++lane) {
+            accumulatePoint(columns, d, i + lane, labels[i + lane], sums, counts);
+        }
+    }
+    const bool changed = _mm_movemask_epi8(same) != 0xFFFF;
+    return assignNearestNdScalar(columns, d, i, end, centroids, k, labels, sums, counts) || changed;
+}
+
+#endif // DATAPLATFORM_X86_SIMD
+
+} // namespace detail
+
+inline AssignNearestNdKernel selectAssignNearestNdKernel() {
+#ifdef DATAPLATFORM_X86_SIMD
+    static const AssignNearestNdKernel kernel = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? &detail::assignNearestNdAvx2 : &detail::assignNearestNdScalar;
+    }();
+    return kernel;
+#else
+    return &detail::assignNearestNdScalar;
+#endif
+}
+
+} // namespace DataPlatform
+
+#endif // NUMERIC_KERNELS_H
\ No newline at end of file
@@ -34,6 +34,7 @@ public:
             std::cout << "\n1. Loading dataset..." << std::endl;
             auto numericDataset = std::dynamic_pointer_cast<NumericDataset>(
                 DatasetFactory::createDataset("NUMERIC"));
+            numericDataset->setExecutor(taskManager_.get());
             
             // ģ
             std::vector<double> sampleData = {1.2, 3.4, 2.1, 5.6, 4.3, 7.8, 6.5};
@@ -91,13 +92,13 @@ public:
             while (taskManager_->getTaskStatus(statsTaskId) != TaskStatus::COMPLETED) {
                 std::this_thread::sleep_for(std::chrono::milliseconds(100));
             }
-            Result statsResult = taskManager_->getTaskResult(statsTaskId);
+            Result statsResult = taskManager_->takeTaskResult(statsTaskId);
             
             // ȴ
             while (taskManager_->getTaskStatus(clusterTaskId) != TaskStatus::COMPLETED) {
                 std::this_thread::sleep_for(std::chrono::milliseconds(100));
             }
-            Result clusterResult = taskManager_->getTaskResult(clusterTaskId);
+            Result clusterResult = taskManager_->takeTaskResult(clusterTaskId);
 
             // 6. չʾ
             std::cout << "\n6. Analysis Results:" << std::endl;
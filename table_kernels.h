@@ -0,0 +1,391 @@
+// table_kernels.h
+#ifndef TABLE_KERNELS_H
+#define TABLE_KERNELS_H
+
+#include "text_kernels.h"
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace DataPlatform {
+
+// CSV/TSV 
+struct CsvDialect {
+    char delimiter;     // '\0' ʾԶʶ𶺺ŻƱ
+    char quote;         // '\0' ʾ
+    bool hasHeader;     // Ϊ
+
+    CsvDialect() : delimiter('\0'), quote('"'), hasHeader(true) {}
+};
+
+//  [p, last) еһָŻз'\n' / '\r'λãû򷵻 last
+//  16 ֽΪλ SSE2 Ƚϣֶͨڵֽڲж
+inline const char* findCsvSpecial(const char* p, const char* last, char delimiter, char quote) {
+#ifdef __SSE2__
+    const __m128i delimiters = _mm_set1_epi8(delimiter);
+    const __m128i quotes = _mm_set1_epi8(quote);
+    const __m128i newlines = _mm_set1_epi8('\n');
+    const __m128i returns = _mm_set1_epi8('\r');
+    while (last - p >= 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, delimiters), _mm_cmpeq_epi8(bytes, quotes)),
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, newlines), _mm_cmpeq_epi8(bytes, returns)));
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 16;
+    }
+#endif
+    for (; p < last; ++p) {
+        const char c = *p;
+        if (c == delimiter || c == quote || c == '\n' || c == '\r') return p;
+    }
+    return last;
+}
+
+//  first ʼһ¼ÿֶλص field(index, begin, end, quoted)
+// һ¼㡣quoted Ϊʱ [begin, end) ڵݣ
+// űʾһţ unescapeCsvFieldҿ԰з
+template<typename FieldCallback>
+inline const char* parseCsvRecord(const char* first, const char* last,
+                                  const CsvDialect& dialect, FieldCallback&& field) {
+    const char delimiter = dialect.delimiter;
+    const char quote = dialect.quote;
+    size_t index = 0;
+    const char* p = first;
+    while (true) {
+        if (quote != '\0' && p < last && *p == quote) {
+            const char* begin = p + 1;
+            const char* q = begin;
+            while (true) {
+                q = static_cast<const char*>(std::memchr(q, quote, static_cast<size_t>(last - q)));
+                if (!q) {
+                    q = last;   // unterminated quote, take the rest of the input
+                    break;
+                }
+                if (q + 1 < last && q[1] == quote) {
+                    q += 2;
+                    continue;
+                }
+                break;
+            }
+            field(index++, begin, q, true);
+            p = q < last ? q + 1 : last;
+            // Anything between the closing quote and the next separator is dropped
+            while (p < last && *p != delimiter && *p != '\n' && *p != '\r') ++p;
+        } else {
+            const char* begin = p;
+            p = findCsvSpecial(p, last, delimiter, quote);
+            // A quote inside an unquoted field is an ordinary character
+            while (p < last && *p != delimiter && *p != '\n' && *p != '\r') {
+                p = findCsvSpecial(p + 1, last, delimiter, quote);
+            }
+            field(index++, begin, p, false);
+        }
+
+        if (p >= last) return last;
+        if (*p == delimiter) {
+            ++p;
+            continue;
+        }
+        if (*p == '\r' && p + 1 < last && p[1] == '\n') {
+            return p + 2;
+        }
+        return p + 1;
+    }
+}
+
+// ԭֶеתţתʱֱӷԭ䣬д scratch
+inline std::string_view unescapeCsvField(const char* begin, const char* end, char quote,
+                                         std::string& scratch) {
+    const size_t length = static_cast<size_t>(end - begin);
+    if (!std::memchr(begin, quote, length)) {
+        return std::string_view(begin, length);
+    }
+    scratch.clear();
+    for (const char* p = begin; p < end; ++p) {
+        scratch.push_back(*p);
+        if (*p == quote && p + 1 < end && p[1] == quote) ++p;
+    }
+    return scratch;
+}
+
+// ڵ 1970-01-01 Howard Hinnant  days_from_civil 㷨
+inline int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+    const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+}
+
+namespace detail {
+
+inline bool readFixedDigits(const char*& p, const char* last, int count, int& value) {
+    if (last - p < count) return false;
+    value = 0;
+    for (int i = 0; i < count; ++i) {
+        const unsigned digit = static_cast<unsigned char>(p[i]) - '0';
+        if (digit > 9) return false;
+        value = value * 10 + static_cast<int>(digit);
+    }
+    p += count;
+    return true;
+}
+
+// Reads up to nine fraction digits as nanoseconds; further digits are truncated
+inline bool readFraction(const char*& p, const char* last, int64_t& nanos) {
+    nanos = 0;
+    int digits = 0;
+    while (p < last && *p >= '0' && *p <= '9') {
+        if (digits < 9) {
+            nanos = nanos * 10 + (*p - '0');
+            ++digits;
+        }
+        ++p;
+    }
+    if (digits == 0) return false;
+    for (; digits < 9; ++digits) nanos *= 10;
+    return true;
+}
+
+inline bool secondsToNanos(int64_t seconds, int64_t fraction, int64_t& nanos) {
+    int64_t scaled;
+    if (__builtin_mul_overflow(seconds, int64_t(1000000000), &scaled)) return false;
+    return !__builtin_add_overflow(scaled, fraction, &nanos);
+}
+
+} // namespace detail
+
+// ʱΪ Unix Ԫ׳쳣֧֣
+//   ISO-8601"YYYY-MM-DD""YYYY-MM-DD[T ]hh:mm[:ss[.fffffffff]]"
+//             ɴ "Z"  "+hh:mm" / "-hhmm" / "+hh" ʱƫƣƫư UTC
+//   ֣Unix 룬ɴС "1700000000.25"
+inline bool parseDateTime(const char* first, const char* last, int64_t& nanos) {
+    while (first < last && isAsciiSpace(static_cast<unsigned char>(*first))) ++first;
+    while (last > first && isAsciiSpace(static_cast<unsigned char>(last[-1]))) --last;
+    if (first == last) return false;
+
+    const char* p = first;
+    int year, month, day;
+    if (last - p >= 10 && p[4] == '-' && p[7] == '-') {
+        if (!detail::readFixedDigits(p, last, 4, year)) return false;
+        ++p;
+        if (!detail::readFixedDigits(p, last, 2, month)) return false;
+        ++p;
+        if (!detail::readFixedDigits(p, last, 2, day)) return false;
+
+        static const int DAYS_IN_MONTH[12] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        if (month < 1 || month > 12 || day < 1 || day > DAYS_IN_MONTH[month - 1]) return false;
+        const bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        if (month == 2 && day == 29 && !leap) return false;
+
+        int hour = 0, minute = 0, second = 0;
+        int64_t fraction = 0;
+        int64_t offsetSeconds = 0;
+        if (p < last) {
+            if (*p != 'T' && *p != 't' && *p != ' ') return false;
+            ++p;
+            if (!detail::readFixedDigits(p, last, 2, hour) || p == last || *p++ != ':' ||
+                !detail::readFixedDigits(p, last, 2, minute)) {
+                return false;
+            }
+            if (p < last && *p == ':') {
+                ++p;
+                if (!detail::readFixedDigits(p, last, 2, second)) return false;
+                if (p < last && (*p == '.' || *p == ',')) {
+                    ++p;
+                    if (!detail::readFraction(p, last, fraction)) return false;
+                }
+            }
+            // second == 60 is accepted as a leap second and rolls over
+            if (hour > 23 || minute > 59 || second > 60) return false;
+
+            if (p < last && (*p == 'Z' || *p == 'z')) {
+                ++p;
+            } else if (p < last && (*p == '+' || *p == '-')) {
+                const int sign = (*p == '-') ? -1 : 1;
+                ++p;
+                int offsetHours = 0, offsetMinutes = 0;
+                if (!detail::readFixedDigits(p, last, 2, offsetHours)) return false;
+                // "+hh:" needs its minutes; "+hh" and "+hhmm" are complete
+                const bool colon = p < last && *p == ':';
+                if (colon) ++p;
+                if ((colon || p < last) && !detail::readFixedDigits(p, last, 2, offsetMinutes)) return false;
+                if (offsetHours > 23 || offsetMinutes > 59) return false;
+                offsetSeconds = sign * (offsetHours * 3600 + offsetMinutes * 60);
+            }
+            if (p != last) return false;
+        }
+
+        const int64_t seconds = daysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day)) * 86400
+                              + hour * 3600 + minute * 60 + second - offsetSeconds;
+        return detail::secondsToNanos(seconds, fraction, nanos);
+    }
+
+    // Epoch seconds
+    const bool negative = (*p == '-');
+    if (*p == '-' || *p == '+') ++p;
+    if (p == last) return false;
+    int64_t seconds = 0;
+    const char* digits = p;
+    while (p < last && *p >= '0' && *p <= '9') {
+        if (__builtin_mul_overflow(seconds, int64_t(10), &seconds) ||
+            __builtin_add_overflow(seconds, int64_t(*p - '0'), &seconds)) {
+            return false;
+        }
+        ++p;
+    }
+    int64_t fraction = 0;
+    if (p < last && *p == '.') {
+        ++p;
+        if (!detail::readFraction(p, last, fraction) && p == digits + 1) return false;
+    } else if (p == digits) {
+        return false;
+    }
+    if (p != last) return false;
+    if (!detail::secondsToNanos(seconds, fraction, nanos)) return false;
+    if (negative) nanos = -nanos;
+    return true;
+}
+
+// 1970-01-01 ڣcivil_from_daysdaysFromCivil 㣩
+inline void civilFromDays(int64_t days, int64_t& year, unsigned& month, unsigned& day) {
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned dayOfEra = static_cast<unsigned>(days - era * 146097);
+    const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const unsigned mp = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<int64_t>(yearOfEra) + era * 400 + (month <= 2);
+}
+
+// ȡԸʱͬȷ
+inline int64_t floorDiv(int64_t value, int64_t divisor) {
+    const int64_t quotient = value / divisor;
+    return (value % divisor != 0 && ((value < 0) != (divisor < 0))) ? quotient - 1 : quotient;
+}
+
+// ʱʽΪ UTC  ISO-8601 ַСֻڷʱ
+inline std::string formatDateTime(int64_t nanos) {
+    const int64_t seconds = floorDiv(nanos, 1000000000);
+    const int64_t fraction = nanos - seconds * 1000000000;
+    const int64_t days = floorDiv(seconds, 86400);
+    const int64_t secondOfDay = seconds - days * 86400;
+    int64_t year;
+    unsigned month, day;
+    civilFromDays(days, year, month, day);
+
+    char buffer[48];
+    int length = std::snprintf(buffer, sizeof(buffer), "%04lld-%02u-%02uT%02d:%02d:%02d",
+        static_cast<long long>(year), month, day, static_cast<int>(secondOfDay / 3600),
+        static_cast<int>(secondOfDay / 60 % 60), static_cast<int>(secondOfDay % 60));
+    if (fraction != 0) {
+        length += std::snprintf(buffer + length, sizeof(buffer) - length, ".%09lld",
+                                static_cast<long long>(fraction));
+    }
+    return std::string(buffer, static_cast<size_t>(length)) + "Z";
+}
+
+// ʱͰȣǷʱ 0
+//  "second" / "minute" / "hour" / "day"λ "15s""5m""6h""1d"
+inline int64_t parseBucketWidth(const std::string& text) {
+    static const std::pair<const char*, int64_t> NAMED[] = {
+        {"second", 1}, {"minute", 60}, {"hour", 3600}, {"day", 86400}};
+    for (const auto& named : NAMED) {
+        if (text == named.first) return named.second * 1000000000;
+    }
+    if (text.size() < 2) return 0;
+
+    int64_t unit;
+    switch (text.back()) {
+        case 's': unit = 1; break;
+        case 'm': unit = 60; break;
+        case 'h': unit = 3600; break;
+        case 'd': unit = 86400; break;
+        default: return 0;
+    }
+    int64_t count = 0;
+    for (size_t i = 0; i + 1 < text.size(); ++i) {
+        const unsigned digit = static_cast<unsigned char>(text[i]) - '0';
+        if (digit > 9 || count > 1000000000) return 0;
+        count = count * 10 + digit;
+    }
+    int64_t width;
+    if (count == 0 || __builtin_mul_overflow(count, unit * 1000000000, &width)) return 0;
+    return width;
+}
+
+// ʱе±꣬ʱͬԭ˳ʱֱӷ 0..n-1
+inline std::vector<size_t> sortedTimeOrder(const std::vector<int64_t>& times) {
+    std::vector<size_t> order(times.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    if (!std::is_sorted(times.begin(), times.end())) {
+        std::stable_sort(order.begin(), order.end(),
+            [&times](size_t a, size_t b) { return times[a] < times[b]; });
+    }
+    return order;
+}
+
+// һʱͰĻܣԼֵʱ NaN ֵĸ͡Сֵֵ
+struct TimeBucket {
+    int64_t start;       // Ͱ㣬
+    uint64_t count;
+    uint64_t valueCount;
+    double sum;
+    double minValue;
+    double maxValue;
+};
+
+// ˳ɨһ鰴ʱݣɷǿʱͰʱ򣩡
+// order Ϊʱ times 򣬷 order ±˳ʣ
+// values Ϊգ skipTime ʱȱʧֵ
+inline std::vector<TimeBucket> rollupTimeBuckets(const int64_t* times, const double* values,
+                                                 const size_t* order, size_t count,
+                                                 int64_t width, int64_t skipTime) {
+    std::vector<TimeBucket> buckets;
+    TimeBucket* current = nullptr;
+    for (size_t i = 0; i < count; ++i) {
+        const size_t row = order ? order[i] : i;
+        const int64_t time = times[row];
+        if (time == skipTime) continue;
+
+        const int64_t start = floorDiv(time, width) * width;
+        if (!current || current->start != start) {
+            buckets.push_back({start, 0, 0, 0.0,
+                               std::numeric_limits<double>::infinity(),
+                               -std::numeric_limits<double>::infinity()});
+            current = &buckets.back();
+        }
+        ++current->count;
+        if (values && !std::isnan(values[row])) {
+            const double value = values[row];
+            ++current->valueCount;
+            current->sum += value;
+            current->minValue = std::min(current->minValue, value);
+            current->maxValue = std::max(current->maxValue, value);
+        }
+    }
+    return buckets;
+}
+
+} // namespace DataPlatform
+
+#endif // TABLE_KERNELS_H
\ No newline at end of file
@@ -7,11 +7,14 @@
 #include "algorithm_module.h"
 #include <chrono>
 #include <queue>
+#include <deque>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <future>
 #include <sstream>
+#include <charconv>
+#include <atomic>
 
 namespace DataPlatform {
 
@@ -53,10 +56,10 @@ private:
     std::string taskId_;
     std::string userId_;
     TaskConfig config_;
-    TaskStatus status_;
+    std::atomic<TaskStatus> status_;   // release after the result is published, acquire on read
     std::shared_ptr<IDataset> dataset_;
     std::shared_ptr<IAlgorithm> algorithm_;
-    Result result_;
+    std::shared_ptr<Result> result_;   // published once, read without copying
     std::chrono::system_clock::time_point creationTime_;
     std::chrono::system_clock::time_point startTime_;
     std::chrono::system_clock::time_point endTime_;
@@ -72,6 +75,7 @@ public:
         , status_(TaskStatus::CREATED)
         , dataset_(dataset)
         , algorithm_(algorithm)
+        , result_(std::make_shared<Result>())
         , creationTime_(std::chrono::system_clock::now())
     {
         // ΨһID
@@ -81,8 +85,8 @@ public:
     // Getters
     std::string getTaskId() const { return taskId_; }
     std::string getUserId() const { return userId_; }
-    TaskStatus getStatus() const { return status_; }
-    const Result& getResult() const { return result_; }
+    TaskStatus getStatus() const { return status_.load(std::memory_order_acquire); }
+    std::shared_ptr<const Result> getResult() const { return std::atomic_load(&result_); }
     const TaskConfig& getConfig() const { return config_; }
     std::chrono::system_clock::time_point getCreationTime() const { return creationTime_; }
     std::chrono::system_clock::time_point getStartTime() const { return startTime_; }
@@ -92,9 +96,64 @@ public:
     // ִ
     bool execute() {
         try {
-            status_ = TaskStatus::RUNNING;
+            status_.store(TaskStatus::RUNNING, std::memory_order_release);
             startTime_ = std::chrono::system_clock::now();
 
+            // ݼǰ汾ĿУݣ÷
+            // ֮޸ݼֻ°汾ݱֲ
+            std::shared_ptr<IDataset> input = dataset_;
+            auto baseDataset = std::dynamic_pointer_cast<BaseDataset>(dataset_);
+            if (baseDataset) {
+                if (auto pinned = baseDataset->snapshot()) {
+                    baseDataset = pinned;
+                    input = pinned;
+                }
+            }
+
+            //  "preprocess" ִԤˮߣֻڱĿ
+            auto preprocessSpec = config_.parameters.find("preprocess");
+            if (preprocessSpec != config_.parameters.end()) {
+                if (!baseDataset ||
+                    !baseDataset->applyPipeline(PreprocessPipeline::parse(preprocessSpec->second))) {
+                    throw PlatformException("Preprocessing pipeline failed");
+                }
+            }
+
+            // ڳͼУsampleFraction Ϊ (0, 1] ڵĳŬ
+            // sampleRows ΪˮسһsampleSeed Ϊӣ
+            // ȱʡʱʹù̶ӣͬ鵽ͬ
+            const auto& parameters = config_.parameters;
+            auto fraction = parameters.find("sampleFraction");
+            auto rows = parameters.find("sampleRows");
+            if (fraction != parameters.end() && rows != parameters.end()) {
+                throw PlatformException("sampleFraction and sampleRows cannot be combined");
+            }
+            auto seedSpec = parameters.find("sampleSeed");
+            const uint64_t seed = seedSpec != parameters.end()
+                ? parseUnsignedParameter("sampleSeed", seedSpec->second)
+                : std::mt19937_64::default_seed;
+            auto streamingDataset = std::dynamic_pointer_cast<StreamingNumericDataset>(input);
+            if (fraction != parameters.end()) {
+                double probability;
+                if (!parseDoubleField(fraction->second, probability) ||
+                    !(probability > 0.0 && probability <= 1.0)) {
+                    throw PlatformException("sampleFraction must be in (0, 1]: " + fraction->second);
+                }
+                if (streamingDataset) {
+                    const double size = probability * static_cast<double>(streamingDataset->getSize());
+                    input = reservoirSample(*streamingDataset, static_cast<size_t>(size), seed);
+                } else {
+                    input = bernoulliSample(input, probability, seed);
+                }
+            } else if (rows != parameters.end()) {
+                const uint64_t count = parseUnsignedParameter("sampleRows", rows->second);
+                if (count == 0) {
+                    throw PlatformException("sampleRows must be positive");
+                }
+                input = streamingDataset ? reservoirSample(*streamingDataset, count, seed)
+                                         : reservoirSample(input, count, seed);
+            }
+
             // 㷨
             for (const auto& param : config_.parameters) {
                 algorithm_->setParameter(param.first, param.second);
@@ -105,39 +164,66 @@ public:
                 throw PlatformException("Algorithm initialization failed");
             }
 
-            // ִ㷨
-            result_ = algorithm_->execute(dataset_);
-
-            // 
-            if (result_.getStatus() == Result::Status::SUCCESS) {
-                status_ = TaskStatus::COMPLETED;
-            } else {
-                status_ = TaskStatus::FAILED;
-                errorMessage_ = result_.getMessage();
+            // ִ㷨빲ٷ
+            auto result = std::make_shared<Result>(algorithm_->execute(input));
+            const bool succeeded = result->getStatus() == Result::Status::SUCCESS;
+            if (!succeeded) {
+                errorMessage_ = result->getMessage();
             }
-
+            std::atomic_store(&result_, std::move(result));
             endTime_ = std::chrono::system_clock::now();
+
+            // 󷢲״̬ɻʧܵ߳ҲܿϢͽʱ
+            status_.store(succeeded ? TaskStatus::COMPLETED : TaskStatus::FAILED,
+                          std::memory_order_release);
             return true;
         }
         catch (const std::exception& e) {
-            status_ = TaskStatus::FAILED;
             errorMessage_ = e.what();
             endTime_ = std::chrono::system_clock::now();
+            status_.store(TaskStatus::FAILED, std::memory_order_release);
             return false;
         }
     }
 
+    // ֻ״̬ϢĽ÷õԭĻ
+    std::shared_ptr<Result> releaseResult() {
+        auto current = std::atomic_load(&result_);
+        while (true) {
+            auto remaining = std::make_shared<Result>();
+            remaining->setStatus(current->getStatus());
+            remaining->setMessage(current->getMessage());
+            remaining->setTimestamp(current->getTimestamp());
+            // On failure the task published meanwhile and current holds the newer result
+            if (std::atomic_compare_exchange_strong(&result_, &current, remaining)) {
+                return current;
+            }
+        }
+    }
+
     // ȡ
     bool cancel() {
-        if (status_ == TaskStatus::QUEUED || status_ == TaskStatus::RUNNING) {
-            status_ = TaskStatus::CANCELLED;
-            endTime_ = std::chrono::system_clock::now();
-            return true;
+        TaskStatus current = status_.load(std::memory_order_acquire);
+        while (current == TaskStatus::QUEUED || current == TaskStatus::RUNNING) {
+            if (status_.compare_exchange_weak(current, TaskStatus::CANCELLED, std::memory_order_acq_rel)) {
+                return true;
+            }
         }
         return false;
     }
 
 private:
+    // ֵʮƷǸ
+    static uint64_t parseUnsignedParameter(const std::string& name, const std::string& text) {
+        uint64_t value = 0;
+        const char* last = text.data() + text.size();
+        auto res = std::from_chars(text.data(), last, value);
+        if (text.empty() || res.ec != std::errc() || res.ptr != last) {
+            throw PlatformException("Invalid " + name + ": " + text);
+        }
+        return value;
+    }
+
     static std::string generateTaskId() {
         static std::atomic<uint64_t> counter(0);
         std::stringstream ss;
@@ -160,11 +246,13 @@ struct TaskComparator {
 };
 
 // 
-class TaskManager {
+// ͬʱʵ IExecutorݼ㷨Ը乤ִ߳взֿ
+class TaskManager : public IExecutor {
 private:
     std::priority_queue<std::shared_ptr<Task>, 
                        std::vector<std::shared_ptr<Task>>,
                        TaskComparator> taskQueue_;
+    std::deque<std::function<void()>> jobQueue_;
     std::map<std::string, std::shared_ptr<Task>> taskMap_;
     std::vector<std::thread> workerThreads_;
     std::mutex mutex_;
@@ -216,14 +304,20 @@ public:
         throw PlatformException("Task not found: " + taskId);
     }
 
-    // ȡ
-    Result getTaskResult(const std::string& taskId) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = taskMap_.find(taskId);
-        if (it != taskMap_.end()) {
-            return it->second->getResult();
+    // ȡعֻֻ񣬲
+    std::shared_ptr<const Result> getTaskResult(const std::string& taskId) {
+        return findTask(taskId)->getResult();
+    }
+
+    // ȡû߳ʱֱƶһ
+    Result takeTaskResult(const std::string& taskId) {
+        std::shared_ptr<Result> result = findTask(taskId)->releaseResult();
+        if (result.use_count() == 1) {
+            // Pairs with the release in other holders' reference drops
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return std::move(*result);
         }
-        throw PlatformException("Task not found: " + taskId);
+        return result->clone();
     }
 
     // ȡ
@@ -236,6 +330,33 @@ public:
         return false;
     }
 
+    // IExecutor: ִзֿ
+    size_t getConcurrency() const override {
+        return std::max<size_t>(maxThreads_, 1);
+    }
+
+    void parallelFor(size_t count, const std::function<void(size_t)>& job) override {
+        if (count == 0) return;
+        auto batch = std::make_shared<ParallelBatch>(count, job);
+
+        // ߳ҲִУʹй̶߳æӹ߳ڵãҲ
+        size_t helperCount = std::min(count, maxThreads_ + 1) - 1;
+        if (helperCount > 0) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (isRunning_) {
+                    for (size_t i = 0; i < helperCount; ++i) {
+                        jobQueue_.emplace_back([batch] { batch->run(); });
+                    }
+                }
+            }
+            condition_.notify_all();
+        }
+
+        batch->run();
+        batch->wait();
+    }
+
     // ر
     void shutdown() {
         {
@@ -252,28 +373,46 @@ public:
     }
 
 private:
+    std::shared_ptr<Task> findTask(const std::string& taskId) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = taskMap_.find(taskId);
+        if (it != taskMap_.end()) {
+            return it->second;
+        }
+        throw PlatformException("Task not found: " + taskId);
+    }
+
     // ̺߳
     void workerFunction() {
         while (true) {
             std::shared_ptr<Task> task;
+            std::function<void()> job;
             
             {
                 std::unique_lock<std::mutex> lock(mutex_);
                 condition_.wait(lock, [this] {
-                    return !isRunning_ || !taskQueue_.empty();
+                    return !isRunning_ || !taskQueue_.empty() || !jobQueue_.empty();
                 });
 
-                if (!isRunning_ && taskQueue_.empty()) {
+                if (!isRunning_ && taskQueue_.empty() && jobQueue_.empty()) {
                     return;
                 }
 
-                if (!taskQueue_.empty()) {
+                // зֿȣĳִеĵ÷
+                if (!jobQueue_.empty()) {
+                    job = std::move(jobQueue_.front());
+                    jobQueue_.pop_front();
+                }
+                else if (!taskQueue_.empty()) {
                     task = taskQueue_.top();
                     taskQueue_.pop();
                 }
             }
 
-            if (task) {
+            if (job) {
+                job();
+            }
+            else if (task) {
                 ++activeThreads_;
                 task->execute();
                 --activeThreads_;
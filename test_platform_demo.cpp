@@ -0,0 +1,1554 @@
+// test_platform_demo.cpp
+// Ϊԣg++ -std=c++17 -O2 -pthread test_platform_demo.cpp -ldl && ./a.out
+// ѹ -DDATAPLATFORM_WITH_ZLIB -lz  -DDATAPLATFORM_WITH_ZSTD -lzstdֹӦͨ
+// ĲֻӦ -fsanitize=thread 
+#include "core_framework.h"
+#include "data_management.h"
+#include "algorithm_module.h"
+#include "task_management.h"
+#include <iostream>
+#include <fstream>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <tuple>
+
+using namespace DataPlatform;
+
+namespace {
+
+int failures = 0;
+
+#define EXPECT(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": EXPECT(" #condition ") failed\n"; \
+            ++failures; \
+        } \
+    } while (0)
+
+std::string writeFile(const std::string& name, const std::string& content) {
+    std::ofstream file(name, std::ios::binary);
+    file << content;
+    return name;
+}
+
+// ֵأнԭ std::getline + std::stod Ľһ£ֻҪǰ׺Ϸ
+// ٱļʧܣڵļ׳쳣
+void testNumericLoaderMatchesStod() {
+    const std::vector<std::string> lines = {
+        "1", "-0.5", " 3 ", "1e3", "12abc", "inf", "-inf", "nan", "0x1p3", "-0x10", "0x", "+5", "+-1",
+        "-+1", ".5", "5.", ".", "-", "", "\r", "1e400", "1e-400", "1,5", "  \t7", "1e", "00012", "-0",
+        "nan(123)", "4.0\r"};
+    std::string content;
+    std::vector<double> expected;
+    size_t expectedSkipped = 0;
+    for (const auto& line : lines) {
+        content += line + "\n";
+        try {
+            expected.push_back(std::stod(line));
+        } catch (const std::exception&) {
+            ++expectedSkipped;
+        }
+    }
+    // The last line has no newline; stod would reject the subnormal as out of range
+    content += "4.9e-324";
+
+    NumericDataset dataset;
+    EXPECT(dataset.load(writeFile("test_stod.txt", content)));
+    expected.push_back(std::numeric_limits<double>::denorm_min());
+    EXPECT(dataset.getSize() == expected.size());
+    EXPECT(dataset.getSkippedLines() == expectedSkipped);
+    bool same = dataset.getSize() == expected.size();
+    for (size_t i = 0; same && i < expected.size(); ++i) {
+        const double value = dataset.getData()[i];
+        same = std::isnan(expected[i]) ? std::isnan(value)
+                                       : value == expected[i] && std::signbit(value) == std::signbit(expected[i]);
+    }
+    EXPECT(same);
+
+    NumericDataset empty;
+    EXPECT(!empty.load(writeFile("test_empty.txt", "")));
+    bool threw = false;
+    try {
+        NumericDataset missing;
+        missing.load("test_does_not_exist.txt");
+    } catch (const PlatformException&) {
+        threw = true;
+    }
+    EXPECT(threw);
+}
+
+// Ӧ׳ PlatformException ʱ true
+bool loadThrowsPlatformException(const std::string& path) {
+    try {
+        NumericDataset dataset;
+        dataset.load(path);
+    } catch (const PlatformException&) {
+        return true;
+    }
+    return false;
+}
+
+// Ƹʽԭأͳļͷͷ𻵡ضʱʧ
+void testBinaryRoundTrip() {
+    std::mt19937_64 rng(3);
+    std::vector<double> values(10000);
+    for (double& x : values) x = static_cast<double>(rng() % 100000) / 7 - 5000;
+    values[10] = -0.0;
+    values[20] = std::numeric_limits<double>::denorm_min();
+    NumericDataset original;
+    original.append(values);
+    EXPECT(original.save("test_binary.bin"));
+
+    for (bool async : {false, true}) {
+        ProcessingOptions options;
+        options.asyncIO = async;
+        NumericDataset loaded;
+        loaded.setProcessingOptions(options);
+        EXPECT(loaded.load("test_binary.bin"));
+        EXPECT(loaded.getMetadata("format") == "binary");
+        EXPECT(std::memcmp(loaded.getData().data(), values.data(), values.size() * sizeof(double)) == 0);
+        EXPECT(loaded.getMean() == original.getMean() && loaded.getStdDev() == original.getStdDev());
+        EXPECT(loaded.getMinValue() == original.getMinValue() && loaded.getMaxValue() == original.getMaxValue());
+
+        // Appending after a binary load continues from the statistics in the header
+        loaded.append(std::vector<double>{1e4, -1e4});
+        NumericDataset reference;
+        reference.append(loaded.getData());
+        EXPECT(std::abs(loaded.getMean() - reference.getMean()) < 1e-9);
+        EXPECT(std::abs(loaded.getStdDev() - reference.getStdDev()) < 1e-9);
+    }
+
+    std::ifstream in("test_binary.bin", std::ios::binary);
+    const std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::string payload = bytes, header = bytes;
+    payload[NumericBinaryHeader::SIZE + 100] ^= 1;
+    header[20] ^= 1;
+    EXPECT(loadThrowsPlatformException(writeFile("test_binary_payload.bin", payload)));
+    EXPECT(loadThrowsPlatformException(writeFile("test_binary_header.bin", header)));
+    EXPECT(loadThrowsPlatformException(writeFile("test_binary_short.bin", bytes.substr(0, bytes.size() - 8))));
+    EXPECT(loadThrowsPlatformException(writeFile("test_binary_long.bin", bytes + "12345678")));
+}
+
+// зֿ˳صõͬݣֿ߽ϣСǷк CRLF
+void testParallelLoadMatchesSequential() {
+    std::mt19937_64 rng(2);
+    std::ostringstream numbers, words;
+    for (int i = 0; i < 20000; ++i) {
+        switch (rng() % 8) {
+            case 0: numbers << "x" << i << "\n"; break;
+            case 1: numbers << "\n"; break;
+            case 2: numbers << "  " << static_cast<double>(rng() % 1000) / 7 << "  \r\n"; break;
+            default: numbers << static_cast<double>(rng() % 100000) / 3 - 10000 << "\n"; break;
+        }
+        words << "w" << rng() % 50 << " W" << rng() % 50 << (i % 3 == 0 ? "\r\n" : "\n");
+    }
+    const std::string numberFile = writeFile("test_parallel_numbers.txt", numbers.str());
+    const std::string wordFile = writeFile("test_parallel_words.txt", words.str());
+
+    ProcessingOptions parallel;
+    parallel.parallel = true;
+    parallel.minChunkBytes = 1000;
+
+    NumericDataset sequential, chunked;
+    chunked.setProcessingOptions(parallel);
+    EXPECT(sequential.load(numberFile));
+    EXPECT(chunked.load(numberFile));
+    EXPECT(chunked.getData() == sequential.getData());
+    EXPECT(chunked.getSkippedLines() == sequential.getSkippedLines());
+    EXPECT(sequential.getSkippedLines() > 0);
+    EXPECT(std::abs(chunked.getMean() - sequential.getMean()) < 1e-9);
+    EXPECT(chunked.getMinValue() == sequential.getMinValue());
+    EXPECT(chunked.getMaxValue() == sequential.getMaxValue());
+
+    for (bool compact : {false, true}) {
+        ProcessingOptions options = parallel;
+        options.compactText = compact;
+        options.minChunkLines = 100;
+        TextDataset sequentialText, chunkedText;
+        sequentialText.setProcessingOptions(ProcessingOptions());
+        chunkedText.setProcessingOptions(options);
+        EXPECT(sequentialText.load(wordFile));
+        EXPECT(chunkedText.load(wordFile));
+        EXPECT(chunkedText.getData() == sequentialText.getData());
+        EXPECT(chunkedText.getWordFrequency() == sequentialText.getWordFrequency());
+    }
+}
+
+// ͳںˣ SIMD ںں˽һ£ƫϵķ鷨һ
+void testStatisticsKernels() {
+    std::mt19937_64 rng(4);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    std::vector<detail::BlockStatsKernel> kernels;
+#ifdef DATAPLATFORM_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) kernels.push_back(&detail::blockStatsAvx2);
+    if (__builtin_cpu_supports("avx512f")) kernels.push_back(&detail::blockStatsAvx512);
+#endif
+    for (size_t n : {1, 3, 7, 8, 9, 15, 16, 17, 1000, 2047, 2048}) {
+        std::vector<double> values(n);
+        for (double& x : values) x = 1e6 + noise(rng);
+        const detail::BlockStats expected = detail::blockStatsScalar(values.data(), n);
+        for (auto kernel : kernels) {
+            const detail::BlockStats actual = kernel(values.data(), n);
+            EXPECT(actual.minValue == expected.minValue);
+            EXPECT(actual.maxValue == expected.maxValue);
+            EXPECT(std::abs(actual.sum - expected.sum) <= 1e-12 * std::abs(expected.sum));
+            EXPECT(std::abs(actual.m2 - expected.m2) <= 1e-9 * expected.m2 + 1e-300);
+        }
+    }
+
+    // min/max skip NaN wherever it sits in the block, on every kernel
+    kernels.push_back(&detail::blockStatsScalar);
+    for (size_t n : {2, 9, 17, 40}) {
+        for (size_t at = 0; at < n; ++at) {
+            std::vector<double> values(n);
+            for (size_t i = 0; i < n; ++i) values[i] = static_cast<double>(i + 1);
+            values[at] = std::numeric_limits<double>::quiet_NaN();
+            const double lo = at == 0 ? 2 : 1;
+            const double hi = at == n - 1 ? static_cast<double>(n - 1) : static_cast<double>(n);
+            for (auto kernel : kernels) {
+                const detail::BlockStats actual = kernel(values.data(), n);
+                EXPECT(actual.minValue == lo && actual.maxValue == hi);
+                EXPECT(std::isnan(actual.sum));
+            }
+        }
+    }
+    std::vector<double> withNan{std::numeric_limits<double>::quiet_NaN(), 1, 2, 3, 4, 5, 6, 7, 8};
+    const StatisticsAccumulator nanStats = computeStatistics(withNan.data(), withNan.size());
+    EXPECT(nanStats.minValue == 1 && nanStats.maxValue == 8);
+
+    // The reference works on offsets from 1e9, which are exact
+    std::vector<double> values(100003);
+    for (double& x : values) x = 1e9 + noise(rng);
+    double offsetMean = 0.0;
+    for (double x : values) offsetMean += x - 1e9;
+    offsetMean /= values.size();
+    double m2 = 0.0;
+    for (double x : values) m2 += (x - 1e9 - offsetMean) * (x - 1e9 - offsetMean);
+    const double mean = 1e9 + offsetMean;
+    const StatisticsAccumulator stats = computeStatistics(values.data(), values.size());
+    EXPECT(stats.count == values.size());
+    EXPECT(std::abs(stats.mean - mean) < 1e-6);
+    EXPECT(std::abs(stats.variance() - m2 / values.size()) < 1e-6 * (m2 / values.size()));
+    EXPECT(stats.minValue == *std::min_element(values.begin(), values.end()));
+    EXPECT(stats.maxValue == *std::max_element(values.begin(), values.end()));
+}
+
+// IQR ˣNaN ӰķλҲᱻ˵
+void testIqrFilterKeepsNan() {
+    NumericDataset dataset;
+    dataset.load(writeFile("test_iqr_nan.txt", "1\n2\nnan\n3\n4\n100\n5\n"));
+    EXPECT(dataset.getSize() == 7);
+    EXPECT(dataset.getOrderedCount() == 6);
+    EXPECT(dataset.preprocess());
+    EXPECT(dataset.getSize() == 6);
+    const auto& data = dataset.getData();
+    EXPECT(std::count_if(data.begin(), data.end(), [](double x) { return std::isnan(x); }) == 1);
+    EXPECT(std::find(data.begin(), data.end(), 100.0) == data.end());
+
+    // ͬݳڴԤʱ߶ֱͼѡ
+    NumericDataset bounded;
+    ProcessingOptions options;
+    options.memoryBudget = 2 * sizeof(double);
+    bounded.setProcessingOptions(options);
+    bounded.load("test_iqr_nan.txt");
+    EXPECT(bounded.getOrderStatistics({1, 4}) == std::vector<double>({2.0, 5.0}));
+    EXPECT(bounded.preprocess());
+    EXPECT(bounded.getSize() == 6);
+
+    // ֻʣ dropna ʱɾ NaN
+    NumericDataset dropped;
+    dropped.load("test_iqr_nan.txt");
+    EXPECT(dropped.applyPipeline(PreprocessPipeline::parse("dropna,iqr")));
+    EXPECT(dropped.getSize() == 5);
+}
+
+// append ݼԼ
+void testAppendSelf() {
+    NumericDataset dataset;
+    dataset.load(writeFile("test_append.txt", "1\n2\n3\n4\n"));
+    dataset.append(dataset.getData());
+    EXPECT(dataset.getData() == std::vector<double>({1, 2, 3, 4, 1, 2, 3, 4}));
+    EXPECT(dataset.getMean() == 2.5);
+    EXPECT(dataset.getMaxValue() == 4.0);
+    dataset.append(dataset.getData().data() + 6, 2);
+    EXPECT(dataset.getSize() == 10);
+    EXPECT(dataset.getData()[9] == 4.0);
+}
+
+bool parses(const std::string& spec) {
+    try {
+        PreprocessPipeline::parse(spec);
+        return true;
+    } catch (const PlatformException&) {
+        return false;
+    }
+}
+
+// Ԥclip ½粻ܴϽ
+void testPipelineParse() {
+    EXPECT(parses("dropna,clip:-1:1,minmax:0:10,iqr:2.5"));
+    EXPECT(parses("clip: 1 :1"));
+    EXPECT(!parses("iqr:1.5x"));
+    EXPECT(!parses("clip:a:1"));
+    EXPECT(!parses("clip:5:1"));
+    EXPECT(!parses("clip:nan:1"));
+    EXPECT(!parses("clip:1"));
+    EXPECT(PreprocessPipeline::parse("clip:-2:3").getStages()[0].second == 3.0);
+
+    double value;
+    EXPECT(!parseDoubleField(nullptr, nullptr, value));
+    EXPECT(!parseDoubleField(std::string(" "), value));
+    EXPECT(parseDoubleField(std::string(" -2.5e1 "), value) && value == -25.0);
+}
+
+// ֿհסظʺͷ ASCII ֽڵıУÿ '\n' β
+std::string randomText(std::mt19937_64& rng, size_t lines) {
+    static const char* const PIECES[] = {"the", "The", "a", "data", "DATA", "x", "\xC3\xA9t\xC3\xA9", "2024",
+                                         " ", " ", "  ", "\t", "\v", "\f", "\r", " \t "};
+    std::string text;
+    for (size_t i = 0; i < lines; ++i) {
+        const size_t pieces = 1 + rng() % 24;
+        for (size_t j = 0; j < pieces; ++j) text += PIECES[rng() % (sizeof(PIECES) / sizeof(PIECES[0]))];
+        text += "w\n";
+    }
+    return text;
+}
+
+// ƵͳƣзƬͳƲ鲢Ľԭ istringstream дʵĽһ
+void testWordCountsMatchStreamSplit() {
+    std::mt19937_64 rng(9);
+    const std::string path = writeFile("test_words.txt", randomText(rng, 5000));
+    std::map<std::string, size_t> expected;
+    std::ifstream in(path, std::ios::binary);
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream words(line);
+        std::string word;
+        while (words >> word) ++expected[word];
+    }
+
+    TaskManager executor(4);
+    for (bool parallel : {false, true}) {
+        ProcessingOptions options;
+        options.parallel = parallel;
+        options.minChunkLines = 64;
+        TextDataset dataset;
+        dataset.setExecutor(&executor);
+        dataset.setProcessingOptions(options);
+        EXPECT(dataset.load(path));
+        EXPECT(dataset.getWordFrequency() == expected);
+        size_t total = 0;
+        for (const auto& entry : expected) total += entry.second;
+        EXPECT(dataset.getMetadata("total_words") == std::to_string(total));
+        EXPECT(dataset.getMetadata("unique_words") == std::to_string(expected.size()));
+        EXPECT(dataset.getWordCounts().count("data") == expected["data"]);
+        EXPECT(dataset.getWordCounts().count("missing") == 0);
+    }
+}
+
+// ʵ֣ԭ preprocess 𲽴תСд۵հױһȥβհף
+std::string referenceNormalize(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 32) : c; });
+    auto isSpace = [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+    text.erase(std::unique(text.begin(), text.end(),
+                           [&](char a, char b) { return isSpace(a) && isSpace(b); }),
+               text.end());
+    const size_t first = text.find_first_not_of(" \t\n\r\f\v");
+    if (first == std::string::npos) return std::string();
+    return text.substr(first, text.find_last_not_of(" \t\n\r\f\v") + 1 - first);
+}
+
+// ı淶SSE2 ·ֽ·Ľʵһ£
+// ǿ 16 ֽڿ߽Ŀհ״ֻհ׵ preprocess ɾ
+void testNormalizeTextMatchesReference() {
+    std::mt19937_64 rng(10);
+    static const char ALPHABET[] = "aZmQ  \t\n\r\v\f\x80\xC3\xFF@[`{09";
+    for (int trial = 0; trial < 20000; ++trial) {
+        std::string text(rng() % 70, ' ');
+        for (char& c : text) c = ALPHABET[rng() % (sizeof(ALPHABET) - 1)];
+        std::string normalized = text;
+        normalized.resize(normalizeText(&normalized[0], normalized.size()));
+        if (normalized != referenceNormalize(text)) {
+            EXPECT(normalized == referenceNormalize(text));
+            break;
+        }
+    }
+
+    std::string content = randomText(rng, 500) + " \t \r\n";
+    TextDataset dataset;
+    EXPECT(dataset.load(writeFile("test_normalize.txt", content)));
+    std::vector<std::string> expected;
+    for (const auto& line : dataset.getData()) {
+        const std::string normalized = referenceNormalize(line);
+        if (!normalized.empty()) expected.push_back(normalized);
+    }
+    EXPECT(dataset.preprocess());
+    EXPECT(dataset.getData() == expected);
+    EXPECT(dataset.getSize() == 500);
+}
+
+// մ洢ء淶֮кʹƵַ洢һ£ͼ getData() һ
+void testCompactTextStorage() {
+    std::mt19937_64 rng(11);
+    const std::string path = writeFile("test_compact.txt", randomText(rng, 3000) + "\n \t\n\nlast line");
+    ProcessingOptions compactOptions;
+    compactOptions.compactText = true;
+    TextDataset strings, compact;
+    compact.setProcessingOptions(compactOptions);
+    EXPECT(strings.load(path));
+    EXPECT(compact.load(path));
+    EXPECT(compact.isCompact() && !strings.isCompact());
+    EXPECT(compact.getMetadata("storage") == "compact");
+
+    for (int pass = 0; pass < 2; ++pass) {
+        EXPECT(compact.getSize() == strings.getSize());
+        EXPECT(compact.getData() == strings.getData());
+        const TextLines lines = compact.getLines();
+        bool same = lines.size() == strings.getSize();
+        for (size_t i = 0; same && i < lines.size(); ++i) {
+            same = lines[i] == strings.getData()[i];
+        }
+        EXPECT(same);
+        EXPECT(compact.getWordFrequency() == strings.getWordFrequency());
+        EXPECT(strings.preprocess() && compact.preprocess());
+    }
+}
+
+// ߵĴƵԿʹ
+void testWordCountTableMove() {
+    WordCountTable table;
+    table.add("alpha");
+    table.add("beta", 2);
+    WordCountTable moved(std::move(table));
+    EXPECT(moved.count("beta") == 2);
+    EXPECT(table.empty() && table.count("alpha") == 0 && table.totalWords() == 0);
+    table.add("gamma");
+    table.add("gamma");
+    EXPECT(table.count("gamma") == 2 && table.size() == 1);
+
+    WordCountTable assigned;
+    assigned = std::move(moved);
+    EXPECT(assigned.count("alpha") == 1 && assigned.totalWords() == 3);
+    EXPECT(moved.topK(5).empty());
+    moved.merge(assigned);
+    EXPECT(moved.count("beta") == 2);
+    WordCountTable copy(table);
+    EXPECT(copy.count("gamma") == 2);
+}
+
+// ʽݼÿֵԤ㣬λһ£NaN 
+void testStreamingMedianWithinBudget() {
+    std::mt19937_64 rng(12);
+    std::ostringstream text;
+    std::vector<double> values;
+    for (int i = 0; i < 20000; ++i) {
+        const double value = static_cast<double>(rng() % 5000) / 8.0;
+        values.push_back(value);
+        text << value << "\n";
+        if (i % 997 == 0) text << "nan\n";
+    }
+    writeFile("test_streaming.txt", text.str());
+    std::sort(values.begin(), values.end());
+
+    StreamingNumericDataset dataset;
+    ProcessingOptions options;
+    options.memoryBudget = 64 << 10;
+    dataset.setProcessingOptions(options);
+    EXPECT(dataset.load("test_streaming.txt"));
+    EXPECT(dataset.getOrderedCount() == values.size());
+
+    size_t largestBatch = 0;
+    dataset.forEachChunk([&](const double*, size_t count) { largestBatch = std::max(largestBatch, count); });
+    EXPECT(largestBatch <= dataset.getValueBatch());
+    EXPECT(dataset.getValueBatch() * sizeof(double) <= options.memoryBudget / 8);
+
+    size_t scans = 0;
+    auto scan = [&](const std::function<void(const double*, size_t)>& consumer) {
+        ++scans;
+        dataset.forEachChunk(consumer);
+    };
+    const size_t n = values.size();
+    auto mid = selectOrderStatisticsStreaming(scan, {n / 2 - 1, n / 2, 0, n - 1}, 0.0, 625.0,
+                                              dataset.getSelectionCapacity());
+    EXPECT(mid == std::vector<double>({values[n / 2 - 1], values[n / 2], values[0], values[n - 1]}));
+    EXPECT(scans <= 3);
+
+    StatisticalAnalysis analysis;
+    auto result = analysis.execute(std::make_shared<StreamingNumericDataset>(dataset));
+    EXPECT(result.getPayload().getScalar("median") == (values[n / 2 - 1] + values[n / 2]) / 2);
+}
+
+[[maybe_unused]] bool loadThrows(IDataset& dataset, const std::string& path) {
+    try {
+        dataset.load(path);
+        return false;
+    } catch (const PlatformException&) {
+        return true;
+    }
+}
+
+// ĩβΪֹÿ capacity ֽ
+std::string readAll(IByteSource& source, size_t capacity) {
+    std::string out;
+    std::vector<char> buffer(capacity);
+    while (size_t n = source.read(buffer.data(), buffer.size())) {
+        out.append(buffer.data(), n);
+    }
+    return out;
+}
+
+// 첽ȡio_uring Ԥֺ߳˰ļ˳򽻸ֽͬڣ
+// asyncIO ڴӳصõͬ
+void testAsyncReadBackends() {
+    std::mt19937_64 rng(13);
+    std::ostringstream text;
+    for (int i = 0; i < 30000; ++i) {
+        text << static_cast<double>(rng() % 1000000) / 8 << (i % 5 == 0 ? "\r\n" : "\n");
+    }
+    const std::string content = text.str();
+    const std::string path = writeFile("test_async.txt", content);
+    const std::string empty = writeFile("test_async_empty.txt", "");
+
+    for (size_t capacity : {size_t(7), size_t(1000), size_t(1) << 16}) {
+        FileByteSource plain(path);
+        EXPECT(readAll(plain, capacity) == content);
+        PrefetchingByteSource prefetching(std::unique_ptr<IByteSource>(new FileByteSource(path)), 4096, 3);
+        EXPECT(readAll(prefetching, capacity) == content);
+        auto fallback = openSequentialSource(path, 4096, 3, false);
+        EXPECT(readAll(*fallback, capacity) == content);
+#ifdef DATAPLATFORM_HAS_IO_URING
+        // The kernel or sandbox may refuse io_uring; openSequentialSource then falls back
+        if (auto uring = UringByteSource::create(path, 4096, 4)) {
+            EXPECT(readAll(*uring, capacity) == content);
+        }
+        if (auto uringEmpty = UringByteSource::create(empty, 4096, 4)) {
+            EXPECT(readAll(*uringEmpty, capacity).empty());
+        }
+#endif
+        auto preferred = openSequentialSource(path, 4096, 3, true);
+        EXPECT(readAll(*preferred, capacity) == content);
+    }
+
+    ProcessingOptions async;
+    async.asyncIO = true;
+    async.minChunkBytes = 4096;
+    NumericDataset mapped, streamed;
+    streamed.setProcessingOptions(async);
+    EXPECT(mapped.load(path));
+    EXPECT(streamed.load(path));
+    EXPECT(streamed.getData() == mapped.getData());
+    EXPECT(streamed.getSize() == 30000);
+
+    TextDataset mappedText, streamedText;
+    streamedText.setProcessingOptions(async);
+    EXPECT(mappedText.load(path));
+    EXPECT(streamedText.load(path));
+    EXPECT(streamedText.getData() == mappedText.getData());
+}
+
+// ѹδѹļͬݣδõĸʽȷĴ
+void testCompressedInput() {
+    TaskManager executor(4);
+    std::ostringstream text;
+    for (int i = 0; i < 60000; ++i) text << i * 0.5 << "\n";
+    const std::string content = text.str();
+    NumericDataset plain;
+    plain.load(writeFile("test_plain.txt", content));
+
+    [[maybe_unused]] const size_t half = content.find('\n', content.size() / 2) + 1;
+#ifdef DATAPLATFORM_WITH_ZLIB
+    // Two gzip members back to back, as written by pigz or cat
+    for (const char* mode : {"wb", "ab"}) {
+        gzFile file = gzopen("test_input.gz", mode);
+        const std::string part = mode[0] == 'w' ? content.substr(0, half) : content.substr(half);
+        gzwrite(file, part.data(), static_cast<unsigned>(part.size()));
+        gzclose(file);
+    }
+    EXPECT(isCompressionSupported(Compression::GZIP));
+    NumericDataset gzip;
+    gzip.setExecutor(&executor);
+    EXPECT(gzip.load("test_input.gz"));
+    EXPECT(gzip.getData() == plain.getData());
+#else
+    writeFile("test_input.gz", std::string("\x1f\x8b\x08\x00", 4));
+    NumericDataset gzip;
+    EXPECT(!isCompressionSupported(Compression::GZIP));
+    EXPECT(loadThrows(gzip, "test_input.gz"));
+#endif
+
+#ifdef DATAPLATFORM_WITH_ZSTD
+    // Many small frames with recorded sizes (decoded in parallel), then one
+    // streamed frame without a content size (decoded incrementally)
+    std::string compressed;
+    size_t offset = 0;
+    while (offset < half) {
+        const size_t end = std::min(half, content.find('\n', offset + 4000) + 1);
+        std::string frame(ZSTD_compressBound(end - offset), '\0');
+        frame.resize(ZSTD_compress(&frame[0], frame.size(), content.data() + offset, end - offset, 3));
+        compressed += frame;
+        offset = end;
+    }
+    ZSTD_CCtx* context = ZSTD_createCCtx();
+    std::string frame(ZSTD_compressBound(content.size() - half), '\0');
+    ZSTD_inBuffer in = {content.data() + half, content.size() - half, 0};
+    ZSTD_outBuffer out = {&frame[0], frame.size(), 0};
+    while (ZSTD_compressStream2(context, &out, &in, ZSTD_e_end) != 0) {}
+    ZSTD_freeCCtx(context);
+    frame.resize(out.pos);
+    compressed += frame;
+    writeFile("test_input.zst", compressed);
+
+    EXPECT(isCompressionSupported(Compression::ZSTD));
+    NumericDataset zstd;
+    zstd.setExecutor(&executor);
+    EXPECT(zstd.load("test_input.zst"));
+    EXPECT(zstd.getData() == plain.getData());
+
+    StreamingNumericDataset streaming;
+    ProcessingOptions options;
+    options.memoryBudget = 1 << 20;
+    streaming.setProcessingOptions(options);
+    streaming.setExecutor(&executor);
+    EXPECT(streaming.load("test_input.zst"));
+    EXPECT(streaming.getSize() == plain.getSize());
+    EXPECT(streaming.getMean() == plain.getMean());
+    // Decoder buffers are charged against the budget as well
+    EXPECT(streaming.getChunkBytes() * (decodedSourceBlocks(Compression::ZSTD, options.readAhead) + 2)
+           <= options.memoryBudget / 2);
+#else
+    writeFile("test_input.zst", std::string("\x28\xb5\x2f\xfd", 4));
+    NumericDataset zstd;
+    EXPECT(!isCompressionSupported(Compression::ZSTD));
+    EXPECT(loadThrows(zstd, "test_input.zst"));
+#endif
+}
+
+// һеȫֵȱʧֵΪ "<missing>"
+std::vector<std::string> columnStrings(const TableDataset& table, const std::string& name) {
+    std::vector<std::string> values;
+    const Column* column = table.findColumn(name);
+    if (!column) return values;
+    for (size_t row = 0; row < table.getSize(); ++row) {
+        values.push_back(column->isMissing(row) ? "<missing>" : column->getValueAsString(row));
+    }
+    return values;
+}
+
+// CSV ŵķָתźͻУCRLFƶϣ
+// ƱԶʶ𣻲зֿ˳һ
+void testCsvQuotingAndTypes() {
+    const std::string path = writeFile("test_quoted.csv",
+        "id,\"name, full\",city,when,note\r\n"
+        "1,\"Smith, J\",Paris,2024-01-01 10:00:00,\"said \"\"hi\"\"\"\r\n"
+        "2,Lee,Paris,2024-01-02,\"two\nlines\"\r\n"
+        "3,,Rome,2024-01-03T05:06:07Z,plain\r\n"
+        "4,\"O'Neil\",Rome,,\"\"\r\n");
+    for (bool parallel : {false, true}) {
+        ProcessingOptions options;
+        options.parallel = parallel;
+        options.minChunkBytes = 16;
+        TableDataset table;
+        table.setProcessingOptions(options);
+        EXPECT(table.load(path));
+        EXPECT(table.getSize() == 4);
+        EXPECT(table.getMetadata("column_types") ==
+               "id:NUMERIC,name, full:TEXT,city:CATEGORICAL,when:DATETIME,note:TEXT");
+        EXPECT(columnStrings(table, "name, full") ==
+               (std::vector<std::string>{"Smith, J", "Lee", "<missing>", "O'Neil"}));
+        EXPECT(columnStrings(table, "city") == (std::vector<std::string>{"Paris", "Paris", "Rome", "Rome"}));
+        EXPECT(columnStrings(table, "when") ==
+               (std::vector<std::string>{"2024-01-01T10:00:00Z", "2024-01-02T00:00:00Z",
+                                         "2024-01-03T05:06:07Z", "<missing>"}));
+        EXPECT(columnStrings(table, "note") ==
+               (std::vector<std::string>{"said \"hi\"", "two\nlines", "plain", "<missing>"}));
+    }
+
+    // Declared types win over inference; only the selected columns are parsed
+    TableDataset selected;
+    selected.selectColumns({"city", "id"});
+    selected.setColumnType("id", DataType::TEXT);
+    EXPECT(selected.load(path));
+    EXPECT(selected.getMetadata("column_types") == "id:TEXT,city:CATEGORICAL");
+    EXPECT(selected.findColumn("note") == nullptr);
+
+    TableDataset tabs;
+    EXPECT(tabs.load(writeFile("test_tabs.tsv", "a\tb\n1\tx,y\n2\t\"q\"\n")));
+    EXPECT(tabs.getMetadata("column_types") == "a:NUMERIC,b:TEXT");
+    EXPECT(columnStrings(tabs, "b") == (std::vector<std::string>{"x,y", "q"}));
+
+    // Without quotes the file is split into chunks at line breaks
+    std::ostringstream csv;
+    csv << "key,value\n";
+    for (int i = 0; i < 5000; ++i) csv << "k" << i % 7 << "," << i * 0.5 << "\n";
+    const std::string plain = writeFile("test_plain.csv", csv.str());
+    ProcessingOptions parallel;
+    parallel.parallel = true;
+    parallel.minChunkBytes = 512;
+    TableDataset sequential, chunked;
+    chunked.setProcessingOptions(parallel);
+    EXPECT(sequential.load(plain));
+    EXPECT(chunked.load(plain));
+    EXPECT(chunked.getSize() == 5000);
+    EXPECT(columnStrings(chunked, "key") == columnStrings(sequential, "key"));
+    EXPECT(columnStrings(chunked, "value") == columnStrings(sequential, "value"));
+}
+
+// ֵУƶϵͶҪֶ
+void testTableNumericFields() {
+    writeFile("test_table.csv",
+        "id,amount,when\n"
+        "1,12abc,2024-01-01\n"
+        "2, 3.5 ,2024-01-02\n"
+        "3,+-4,2024-01-03\n"
+        "4,0x10,2024-01-04\n"
+        "5,\"7\",2024-01-05\n");
+    TableDataset table;
+    table.setColumnType("amount", DataType::NUMERIC);
+    table.setColumnType("when", DataType::NUMERIC);
+    EXPECT(table.load("test_table.csv"));
+    const auto* amount = table.getColumnAs<NumericColumn>("amount");
+    const auto* when = table.getColumnAs<NumericColumn>("when");
+    EXPECT(amount && when);
+    if (!amount || !when) return;
+    const auto& values = amount->getValues();
+    EXPECT(std::isnan(values[0]) && values[1] == 3.5 && std::isnan(values[2]));
+    EXPECT(values[3] == 16.0 && values[4] == 7.0);
+    EXPECT(amount->getInvalidCount() == 2);
+    EXPECT(when->getInvalidCount() == 5);
+
+    // Without declarations, "amount" is not numeric and "when" holds dates
+    TableDataset inferred;
+    EXPECT(inferred.load("test_table.csv"));
+    EXPECT(inferred.getColumnAs<NumericColumn>("id") != nullptr);
+    EXPECT(inferred.getColumnAs<NumericColumn>("amount") == nullptr);
+    EXPECT(inferred.getColumnAs<NumericColumn>("when") == nullptr);
+}
+
+//  GroupBy  -> (, ֵ, )
+using GroupTotals = std::map<std::string, std::tuple<int64_t, int64_t, double>>;
+GroupTotals groupBy(std::shared_ptr<IDataset> dataset,
+                                                          const std::string& groupColumn,
+                                                          const std::string& valueColumn) {
+    auto algorithm = AlgorithmFactory::createAlgorithm("GroupBy");
+    algorithm->setParameter("groupBy", groupColumn);
+    algorithm->setParameter("value", valueColumn);
+    algorithm->setParameter("limit", "0");
+    EXPECT(algorithm->initialize());
+    Result result = algorithm->execute(dataset);
+    EXPECT(result.getStatus() == Result::Status::SUCCESS);
+    GroupTotals groups;
+    if (result.getStatus() != Result::Status::SUCCESS) return groups;
+    const ResultTable& table = result.getPayload().getTable("top_groups");
+    const auto& names = table.getStrings("group");
+    const auto& counts = table.getIntegers("count");
+    EXPECT(valueColumn.empty() == (table.findColumn("value_count") == nullptr));
+    for (size_t i = 0; i < table.getRowCount(); ++i) {
+        EXPECT(i == 0 || counts[i - 1] > counts[i] || (counts[i - 1] == counts[i] && names[i - 1] < names[i]));
+        groups[names[i]] = valueColumn.empty()
+            ? std::make_tuple(counts[i], int64_t(0), 0.0)
+            : std::make_tuple(counts[i], table.getIntegers("value_count")[i], table.getNumbers("sum")[i]);
+    }
+    return groups;
+}
+
+// ۺϣϵļͬе std::map һ£ݴ󵽷ֳɶβУ
+// ֿغϲֵ˳һ£ͼֻۺѡе
+void testGroupByMatchesReference() {
+    TaskManager executor(4);
+    std::mt19937_64 rng(16);
+    std::ostringstream lines, csv;
+    std::vector<std::string> keys;
+    std::vector<double> amounts;
+    GroupTotals expectedCounts, expectedSums, expectedStrided;
+    csv << "key,amount\n";
+    for (size_t i = 0; i < 300000; ++i) {
+        // Group "none" never has an amount, the others miss one row in twenty
+        const size_t draw = rng() % 100;
+        const std::string key = draw == 0 ? "" : draw == 1 ? "none" : "c" + std::to_string(rng() % 50);
+        const bool hasAmount = key != "none" && rng() % 20 != 0;
+        const double amount = static_cast<double>(rng() % 1000);
+        lines << key << "\n";
+        csv << key << "," << (hasAmount ? std::to_string(static_cast<int>(amount)) : "") << "\n";
+        if (key.empty()) continue;
+        ++std::get<0>(expectedCounts[key]);
+        for (GroupTotals* expected : {&expectedSums, &expectedStrided}) {
+            if (expected == &expectedStrided && i % 3 != 0) continue;
+            auto& totals = (*expected)[key];
+            ++std::get<0>(totals);
+            if (!hasAmount) continue;
+            ++std::get<1>(totals);
+            std::get<2>(totals) += amount;
+        }
+    }
+    const std::string linePath = writeFile("test_groups.txt", lines.str());
+    const std::string csvPath = writeFile("test_groups.csv", csv.str());
+
+    ProcessingOptions parallel;
+    parallel.parallel = true;
+    parallel.minChunkBytes = 4096;
+    auto sequential = std::make_shared<CategoricalDataset>();
+    auto chunked = std::make_shared<CategoricalDataset>();
+    chunked->setExecutor(&executor);
+    chunked->setProcessingOptions(parallel);
+    EXPECT(sequential->load(linePath));
+    EXPECT(chunked->load(linePath));
+    EXPECT(chunked->getSize() == sequential->getSize());
+    bool sameValues = true;
+    for (size_t i = 0; i < sequential->getSize(); ++i) {
+        sameValues = sameValues && chunked->getColumn().getValueAsString(i) ==
+                                   sequential->getColumn().getValueAsString(i);
+    }
+    EXPECT(sameValues);
+    EXPECT(groupBy(sequential, "", "") == expectedCounts);
+    EXPECT(groupBy(chunked, "", "") == expectedCounts);
+
+    // Integer amounts keep the sums exact whatever the merge order
+    auto table = std::make_shared<TableDataset>();
+    table->setExecutor(&executor);
+    table->setColumnType("key", DataType::CATEGORICAL);
+    EXPECT(table->load(csvPath));
+    EXPECT(groupBy(table, "key", "amount") == expectedSums);
+    auto strided = makeView(table, RowSelection::strided(0, 3, (table->getSize() + 2) / 3));
+    EXPECT(groupBy(strided, "key", "amount") == expectedStrided);
+
+    // count is the row count whether or not a value column is given, and a
+    // group without any value is still listed, with no sum or mean
+    const GroupTotals counted = groupBy(table, "key", "");
+    const GroupTotals summed = groupBy(table, "key", "amount");
+    EXPECT(counted.size() == summed.size());
+    for (const auto& group : summed) {
+        EXPECT(counted.count(group.first) && std::get<0>(counted.at(group.first)) == std::get<0>(group.second));
+    }
+    EXPECT(summed.count("none") && std::get<1>(summed.at("none")) == 0);
+    auto algorithm = AlgorithmFactory::createAlgorithm("GroupBy");
+    algorithm->setParameter("groupBy", "key");
+    algorithm->setParameter("value", "amount");
+    algorithm->setParameter("limit", "0");
+    EXPECT(algorithm->initialize());
+    std::ostringstream none;
+    none << "\nnone: count=" << std::get<0>(expectedSums["none"]) << "\n";
+    EXPECT(algorithm->execute(table).getData().find(none.str()) != std::string::npos);
+}
+
+// ַʱʧʱ INT64_MIN
+int64_t parseTimestamp(const std::string& text) {
+    int64_t nanos;
+    return parseDateTime(text.data(), text.data() + text.size(), nanos) ? nanos
+                                                                        : std::numeric_limits<int64_t>::min();
+}
+
+// ʱʱƫơꡢ롢СԪı߽
+void testDateTimeParsing() {
+    const int64_t invalid = std::numeric_limits<int64_t>::min();
+    const int64_t base = parseTimestamp("2024-03-01T12:00:00Z");
+    EXPECT(base == 1709294400LL * 1000000000);
+    EXPECT(parseTimestamp("2024-03-01 12:00") == base);
+    EXPECT(parseTimestamp("  2024-03-01T12:00:00  ") == base);
+    EXPECT(parseTimestamp("2024-03-01T17:00:00+05:00") == base);
+    EXPECT(parseTimestamp("2024-03-01T17:00:00+0500") == base);
+    EXPECT(parseTimestamp("2024-03-01T17:00:00+05") == base);
+    EXPECT(parseTimestamp("2024-03-01T10:30:00-01:30") == base);
+    EXPECT(parseTimestamp("2024-03-01T17:00:00+05:") == invalid);
+    EXPECT(parseTimestamp("2024-03-01T17:00:00+5") == invalid);
+    EXPECT(parseTimestamp("2024-03-01T17:00:00+05:3") == invalid);
+    EXPECT(parseTimestamp("2024-03-01T17:00:00+050") == invalid);
+    EXPECT(parseTimestamp("2024-03-01T17:00:00+24:00") == invalid);
+    EXPECT(parseTimestamp("2024-03-01T12:00:00ZZ") == invalid);
+    EXPECT(parseTimestamp("2024-03-01T") == invalid);
+    EXPECT(parseTimestamp("2024-03-01T24:00") == invalid);
+
+    EXPECT(parseTimestamp("2024-02-29") != invalid);
+    EXPECT(parseTimestamp("2000-02-29") != invalid);
+    EXPECT(parseTimestamp("2023-02-29") == invalid);
+    EXPECT(parseTimestamp("1900-02-29") == invalid);
+    EXPECT(parseTimestamp("2024-04-31") == invalid);
+    EXPECT(parseTimestamp("2024-13-01") == invalid);
+    EXPECT(parseTimestamp("2016-12-31T23:59:60Z") == parseTimestamp("2017-01-01T00:00:00Z"));
+
+    EXPECT(parseTimestamp("1969-12-31T23:59:59.5Z") == -500000000);
+    EXPECT(formatDateTime(-500000000) == "1969-12-31T23:59:59.500000000Z");
+    EXPECT(parseTimestamp("2024-03-01T12:00:00.1234567891Z") == base + 123456789);
+    EXPECT(parseTimestamp("2024-03-01T12:00:00.Z") == invalid);
+
+    EXPECT(parseTimestamp("1700000000.25") == 1700000000250000000LL);
+    EXPECT(parseTimestamp("-1.5") == -1500000000);
+    EXPECT(parseTimestamp(".") == invalid);
+    EXPECT(parseTimestamp("-") == invalid);
+    EXPECT(parseTimestamp("") == invalid);
+    EXPECT(parseTimestamp("12abc") == invalid);
+    EXPECT(parseTimestamp("99999999999999999999") == invalid);
+    EXPECT(formatDateTime(base) == "2024-03-01T12:00:00Z");
+}
+
+// ʱͰʹ initialize() Ͱ
+void testTimeBucketWidth() {
+    auto dataset = std::make_shared<DateTimeDataset>();
+    EXPECT(dataset->load(writeFile("test_times.txt",
+        "2024-01-01T00:10:00Z,1\n2024-01-01T00:50:00Z,2\n2024-01-01T01:05:00Z,4\n")));
+    TimeBucketAggregation rollup;
+    rollup.setParameter("bucket", "hour");
+    EXPECT(rollup.initialize());
+    auto result = rollup.execute(dataset);
+    const ResultTable& buckets = result.getPayload().getTable("buckets");
+    EXPECT(buckets.getRowCount() == 2);
+    EXPECT(buckets.getIntegers("count") == std::vector<int64_t>({2, 1}));
+    EXPECT(buckets.getNumbers("sum") == std::vector<double>({3.0, 4.0}));
+
+    rollup.setParameter("bucket", "fortnight-ish");
+    EXPECT(!rollup.initialize());
+}
+
+// ݼͼ䡢Ȳ±бͼͼϵͳƽ븴Ƴһ£
+// 䲻ݣͼ̶ʱݰ汾
+void testDatasetViews() {
+    std::mt19937_64 rng(18);
+    std::vector<double> values(5000);
+    for (double& x : values) x = static_cast<double>(rng() % 100000) / 9;
+    auto dataset = std::make_shared<NumericDataset>();
+    dataset->append(values);
+
+    std::vector<size_t> picked(777);
+    for (size_t& row : picked) row = rng() % values.size();
+    auto indexed = makeView(dataset, RowSelection::indices(picked));
+    const std::shared_ptr<DatasetView> views[] = {
+        makeView(dataset, RowSelection::range(100, 4100)),
+        makeView(dataset, RowSelection::strided(7, 3, 1000)),
+        indexed,
+        makeView(indexed, RowSelection::strided(1, 5, 150))};
+
+    auto algorithm = AlgorithmFactory::createAlgorithm("StatisticalAnalysis");
+    EXPECT(algorithm->initialize());
+    for (const auto& view : views) {
+        auto copy = std::make_shared<NumericDataset>();
+        std::vector<double> selected;
+        for (size_t i = 0; i < view->getSize(); ++i) selected.push_back(values[view->getRows()[i]]);
+        copy->append(selected);
+        const ResultPayload viewStats = algorithm->execute(view).getPayload();
+        const ResultPayload copyStats = algorithm->execute(copy).getPayload();
+        EXPECT(std::abs(viewStats.getScalar("mean") - copyStats.getScalar("mean")) < 1e-9);
+        EXPECT(viewStats.getScalar("median") == copyStats.getScalar("median"));
+        EXPECT(viewStats.getScalar("min") == copyStats.getScalar("min"));
+        EXPECT(viewStats.getScalar("max") == copyStats.getScalar("max"));
+    }
+    EXPECT(views[3]->getSize() == 150 && views[3]->getParent() == indexed->getParent());
+    EXPECT(views[3]->getRows()[0] == picked[1] && views[3]->getRows()[149] == picked[746]);
+
+    const double* block = nullptr;
+    views[0]->forEachValueBlock(dataset->getData().data(), 0, views[0]->getSize(),
+                                [&block](const double* values, size_t) { block = values; });
+    EXPECT(block == dataset->getData().data() + 100);
+
+    dataset->append(std::vector<double>(10, 1e9));
+    EXPECT(views[0]->getParent()->getSize() == 5000);
+    EXPECT(algorithm->execute(views[0]).getPayload().getScalar("max") < 1e9);
+
+    auto outOfRange = [&](const std::function<void()>& select) {
+        try {
+            select();
+        } catch (const PlatformException&) {
+            return true;
+        }
+        return false;
+    };
+    EXPECT(outOfRange([&] { makeView(views[0]->getParent(), RowSelection::range(0, 5001)); }));
+    // A stride whose last row wraps around size_t must not slip past the bounds check
+    EXPECT(outOfRange([&] { makeView(dataset, RowSelection::strided(0, size_t(1) << 63, 3)); }));
+    EXPECT(outOfRange([] { RowSelection::strided(std::numeric_limits<size_t>::max(), 1, 1); }));
+    EXPECT(RowSelection::strided(5, std::numeric_limits<size_t>::max(), 1)[0] == 5);
+}
+
+// չݻ֮˫޸Ļɼ
+void testSnapshotIsolation() {
+    auto numeric = std::make_shared<NumericDataset>();
+    numeric->load(writeFile("test_snapshot.txt", "1\n2\n3\n4\n100\n"));
+    auto pinned = std::dynamic_pointer_cast<NumericDataset>(numeric->snapshot());
+    EXPECT(&pinned->getData() == &numeric->getData());
+    numeric->append(std::vector<double>{5, 6});
+    EXPECT(numeric->preprocess());
+    EXPECT(pinned->getData() == std::vector<double>({1, 2, 3, 4, 100}));
+    EXPECT(pinned->getMaxValue() == 100.0);
+    EXPECT(pinned->applyPipeline(PreprocessPipeline::parse("clip:0:10")));
+    EXPECT(numeric->getData() == std::vector<double>({1, 2, 3, 4, 5, 6}));
+
+    auto table = std::make_shared<TableDataset>();
+    table->load(writeFile("test_snapshot.csv", "a,b\n1,x\n,y\n3,z\n"));
+    auto tableSnapshot = std::dynamic_pointer_cast<TableDataset>(table->snapshot());
+    EXPECT(&tableSnapshot->getColumn(0) == &table->getColumn(0));
+    EXPECT(table->preprocess());
+    EXPECT(table->getSize() == 2 && tableSnapshot->getSize() == 3);
+    EXPECT(tableSnapshot->getColumn(1).getValueAsString(1) == "y");
+    EXPECT(table->getColumn(1).getValueAsString(1) == "z");
+    EXPECT(tableSnapshot->getVersion() != table->getVersion());
+}
+
+// ύĳ汾У׷ʱÿӦ׷ǰĳǰ׺
+void testConcurrentTasksAndAppend() {
+    TaskManager manager(3);
+    auto dataset = std::make_shared<NumericDataset>();
+    dataset->setExecutor(&manager);
+    dataset->append(std::vector<double>(1000, 0.0));
+
+    std::vector<std::string> ids;
+    for (int batch = 1; batch <= 20; ++batch) {
+        TaskConfig config;
+        config.taskName = "stats";
+        ids.push_back(manager.submitTask("test", config, dataset,
+                                         AlgorithmFactory::createAlgorithm("StatisticalAnalysis")));
+        // Batch k holds 1000 copies of k, so a snapshot with max k has mean and median k/2
+        dataset->append(std::vector<double>(1000, static_cast<double>(batch)));
+    }
+    for (const auto& id : ids) {
+        while (true) {
+            const TaskStatus status = manager.getTaskStatus(id);
+            if (status == TaskStatus::COMPLETED || status == TaskStatus::FAILED) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT(manager.getTaskStatus(id) == TaskStatus::COMPLETED);
+        auto result = manager.getTaskResult(id);
+        const ResultPayload& payload = result->getPayload();
+        const double k = payload.getScalar("max");
+        EXPECT(k == std::floor(k) && k <= 20);
+        EXPECT(std::abs(payload.getScalar("mean") - k / 2) < 1e-9);
+        EXPECT(payload.getScalar("median") == k / 2);
+    }
+    EXPECT(dataset->getSize() == 21000);
+}
+
+// һͳ񲢵ȴʧʱؿָ
+std::shared_ptr<const Result> runStatistics(TaskManager& manager, std::shared_ptr<IDataset> dataset,
+                                            const std::map<std::string, std::string>& parameters) {
+    TaskConfig config;
+    config.taskName = "stats";
+    config.parameters = parameters;
+    const std::string id = manager.submitTask("test", config, dataset,
+                                              AlgorithmFactory::createAlgorithm("StatisticalAnalysis"));
+    TaskStatus status;
+    while ((status = manager.getTaskStatus(id)) != TaskStatus::COMPLETED && status != TaskStatus::FAILED) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return status == TaskStatus::COMPLETED ? manager.getTaskResult(id) : nullptr;
+}
+
+// ֿΪӾ鵽
+void testSamplingParameters() {
+    TaskManager manager(2);
+    auto dataset = std::make_shared<NumericDataset>();
+    std::vector<double> values(1000);
+    for (size_t i = 0; i < values.size(); ++i) values[i] = static_cast<double>(i);
+    dataset->append(values);
+
+    auto whole = runStatistics(manager, dataset, {{"sampleFraction", "1.0"}});
+    EXPECT(whole && whole->getPayload().getScalar("sample_size") == 1000);
+    EXPECT(whole && whole->getPayload().getScalar("mean_margin") == 0.0);
+
+    auto single = runStatistics(manager, dataset, {{"sampleRows", "1"}});
+    EXPECT(single && single->getPayload().getScalar("sample_size") == 1);
+    EXPECT(single && std::isinf(single->getPayload().getScalar("mean_margin")));
+    std::ostringstream rendered;
+    if (single) single->writeData(rendered);
+    EXPECT(rendered.str().find("undefined") != std::string::npos);
+
+    auto tenth = runStatistics(manager, dataset, {{"sampleFraction", "0.1"}, {"sampleSeed", "7"}});
+    auto again = runStatistics(manager, dataset, {{"sampleFraction", "0.1"}, {"sampleSeed", "7"}});
+    auto other = runStatistics(manager, dataset, {{"sampleFraction", "0.1"}, {"sampleSeed", "8"}});
+    EXPECT(tenth && again && other);
+    if (tenth && again && other) {
+        EXPECT(tenth->getPayload().getScalar("mean") == again->getPayload().getScalar("mean"));
+        EXPECT(tenth->getPayload().getScalar("mean") != other->getPayload().getScalar("mean"));
+        EXPECT(std::isfinite(tenth->getPayload().getScalar("mean_margin")));
+    }
+
+    EXPECT(!runStatistics(manager, dataset, {{"sampleFraction", "0.5"}, {"sampleRows", "10"}}));
+    EXPECT(!runStatistics(manager, dataset, {{"sampleFraction", "1.5"}}));
+    EXPECT(!runStatistics(manager, dataset, {{"sampleRows", "10x"}}));
+    EXPECT(!runStatistics(manager, dataset, {{"sampleRows", "0"}}));
+    EXPECT(!runStatistics(manager, dataset, {{"sampleSeed", "-1"}, {"sampleRows", "10"}}));
+}
+
+// 磺200 鲻ͬӵУ95% 串ʵֵıӽ 95%
+void testSamplingCoverage() {
+    std::mt19937_64 rng(20);
+    std::lognormal_distribution<double> skewed(0.0, 0.75);
+    auto dataset = std::make_shared<NumericDataset>();
+    std::vector<double> values(20000);
+    for (double& x : values) x = skewed(rng);
+    dataset->append(values);
+    const double truth = dataset->getMean();
+    const std::vector<uint32_t> strata = valueStrata(*dataset, 4);
+
+    auto algorithm = AlgorithmFactory::createAlgorithm("StatisticalAnalysis");
+    EXPECT(algorithm->initialize());
+    const int trials = 200;
+    int covered[3] = {0, 0, 0};
+    for (int trial = 0; trial < trials; ++trial) {
+        const uint64_t seed = 1000 + static_cast<uint64_t>(trial);
+        const std::shared_ptr<DatasetView> samples[3] = {
+            reservoirSample(dataset, 400, seed),
+            bernoulliSample(dataset, 0.02, seed),
+            stratifiedSample(dataset, strata, 400, seed)};
+        for (int method = 0; method < 3; ++method) {
+            Result result = algorithm->execute(samples[method]);
+            const ResultPayload& payload = result.getPayload();
+            covered[method] += std::abs(payload.getScalar("mean") - truth) <= payload.getScalar("mean_margin");
+        }
+    }
+    for (int method = 0; method < 3; ++method) {
+        // Binomial spread over 200 trials is about 1.5 points
+        EXPECT(covered[method] >= 0.90 * trials && covered[method] <= 0.99 * trials);
+    }
+}
+
+// ṹֱֵӶȡȾıԭ ostringstream ƴӵĸʽͬ
+void testTypedResultPayloads() {
+    auto numbers = std::make_shared<NumericDataset>();
+    numbers->append(std::vector<double>{10, 2, 3, 1, 4});
+    Result stats = AlgorithmFactory::createAlgorithm("StatisticalAnalysis")->execute(numbers);
+    EXPECT(stats.getPayload().getScalar("median") == 3);
+    EXPECT(stats.getData() ==
+           "Statistical Analysis Results:\nMean: 4\nStandard Deviation: 3.16228\nMin: 1\nMax: 10\nMedian: 3\n");
+
+    auto clusters = std::make_shared<NumericDataset>();
+    clusters->append(std::vector<double>{1, 2, 3, 11, 12, 13});
+    auto kmeans = AlgorithmFactory::createAlgorithm("KMeansClustering");
+    kmeans->setParameter("k", "2");
+    EXPECT(kmeans->initialize());
+    Result clustered = kmeans->execute(clusters);
+    EXPECT(clustered.getPayload().getArray("centroids") == (std::vector<double>{2, 12}));
+    std::ostringstream kmeansText;
+    kmeansText << "K-means Clustering Results:\nNumber of clusters: 2\nNumber of iterations: "
+               << static_cast<int>(clustered.getPayload().getScalar("iterations"))
+               << "\nFinal centroids:\nCluster 0: 2\nCluster 1: 12\n";
+    EXPECT(clustered.getData() == kmeansText.str());
+
+    auto text = std::make_shared<TextDataset>();
+    EXPECT(text->load(writeFile("test_payload_words.txt", "b a c a\nb a\n")));
+    Result words = AlgorithmFactory::createAlgorithm("TextAnalysis")->execute(text);
+    EXPECT(words.getData() ==
+           "Text Analysis Results:\nTotal unique words: 3\nTop 10 most frequent words:\n"
+           "a: 3 occurrences\nb: 2 occurrences\nc: 1 occurrences\n");
+
+    // Text set explicitly wins over the payload; without a renderer the generic form is used
+    Result plain;
+    ResultPayload payload;
+    payload.setScalar("answer", 42);
+    plain.setPayload(std::move(payload));
+    EXPECT(plain.getData().find("answer") != std::string::npos);
+    plain.setData("fixed");
+    EXPECT(plain.getData() == "fixed");
+    plain.setData("");
+    ResultPayload replaced;
+    replaced.setScalar("question", 6 * 7);
+    plain.setPayload(std::move(replaced));
+    EXPECT(plain.getData().find("question") != std::string::npos && plain.getData().find("answer") == std::string::npos);
+}
+
+// ȡ˳ʱƶԭжʱƣֻ֮״̬Ϣ
+void testTakeTaskResult() {
+    TaskManager manager(2);
+    auto dataset = std::make_shared<NumericDataset>();
+    dataset->append(std::vector<double>{1, 2, 3, 11, 12, 13});
+    auto runKMeans = [&]() {
+        TaskConfig config;
+        config.taskName = "kmeans";
+        config.parameters["k"] = "2";
+        const std::string id = manager.submitTask("test", config, dataset,
+                                                  AlgorithmFactory::createAlgorithm("KMeansClustering"));
+        TaskStatus status;
+        while ((status = manager.getTaskStatus(id)) != TaskStatus::COMPLETED && status != TaskStatus::FAILED) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT(status == TaskStatus::COMPLETED);
+        return id;
+    };
+
+    // Sole holder: the taken result owns the very buffer the task produced
+    const std::string moved = runKMeans();
+    const double* buffer = manager.getTaskResult(moved)->getPayload().getArray("centroids").data();
+    Result taken = manager.takeTaskResult(moved);
+    EXPECT(taken.getPayload().getArray("centroids").data() == buffer);
+    EXPECT(taken.getPayload().getArray("centroids") == (std::vector<double>{2, 12}));
+    auto remaining = manager.getTaskResult(moved);
+    EXPECT(remaining->getStatus() == Result::Status::SUCCESS);
+    EXPECT(remaining->getPayload().empty() && remaining->getData().empty());
+    EXPECT(remaining->getMessage() == taken.getMessage());
+
+    // A reader still holds the result: it gets a copy and the reader's view stays intact
+    const std::string cloned = runKMeans();
+    auto reader = manager.getTaskResult(cloned);
+    // Readers polling a shared result render it once and all see the same text
+    std::vector<const std::string*> texts(4, nullptr);
+    std::vector<std::thread> pollers;
+    for (size_t i = 0; i < texts.size(); ++i) {
+        pollers.emplace_back([&, i] { texts[i] = &manager.getTaskResult(cloned)->getData(); });
+    }
+    for (auto& poller : pollers) poller.join();
+    for (const std::string* text : texts) EXPECT(text == &reader->getData());
+    EXPECT(reader->getData().find("Cluster 1: 12") != std::string::npos);
+    Result copy = manager.takeTaskResult(cloned);
+    EXPECT(copy.getPayload().getArray("centroids").data() != reader->getPayload().getArray("centroids").data());
+    EXPECT(copy.getPayload().getArray("centroids") == reader->getPayload().getArray("centroids"));
+    EXPECT(copy.getData() == reader->getData());
+    EXPECT(manager.getTaskResult(cloned)->getPayload().empty());
+}
+
+// ʵ֣Ƚϵ Lloyd ͬȡ±Сģմرԭ
+std::vector<double> referenceKMeans(const std::vector<double>& data, std::vector<double> centroids,
+                                    int maxIterations, int& iterations) {
+    std::vector<int> labels(data.size(), 0);
+    bool changed = true;
+    iterations = 0;
+    while (changed && iterations < maxIterations) {
+        changed = false;
+        std::vector<double> sums(centroids.size(), 0.0);
+        std::vector<size_t> counts(centroids.size(), 0);
+        for (size_t i = 0; i < data.size(); ++i) {
+            int nearest = 0;
+            for (size_t c = 1; c < centroids.size(); ++c) {
+                if (std::abs(data[i] - centroids[c]) < std::abs(data[i] - centroids[nearest])) {
+                    nearest = static_cast<int>(c);
+                }
+            }
+            changed |= labels[i] != nearest;
+            labels[i] = nearest;
+            sums[nearest] += data[i];
+            ++counts[nearest];
+        }
+        for (size_t c = 0; c < centroids.size(); ++c) {
+            if (counts[c] > 0) centroids[c] = sums[c] / counts[c];
+        }
+        ++iterations;
+    }
+    return centroids;
+}
+
+// һά k-means ķ䣺AVX2 ںںλһ£ͬĵ㣩
+// ·仮Ƚһ£ɨ·ʵֵĽ
+void testKMeansAssignmentPaths() {
+    std::mt19937_64 rng(23);
+    std::vector<AssignNearestKernel> kernels;
+#ifdef DATAPLATFORM_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) kernels.push_back(&detail::assignNearestAvx2);
+#endif
+    for (size_t n : {5, 8, 1003}) {
+        for (size_t k : {1, 3, 8, 13}) {
+            // Integer data and half-integer or repeated centroids produce many exact ties
+            std::vector<double> data(n), centroids(k);
+            for (double& x : data) x = static_cast<double>(rng() % 20);
+            for (double& c : centroids) c = static_cast<double>(rng() % 40) / 2;
+            std::vector<int> initial(n);
+            for (int& label : initial) label = static_cast<int>(rng() % k);
+
+            std::vector<int> labels = initial;
+            std::vector<double> sums(k, 0.0);
+            std::vector<uint64_t> counts(k, 0);
+            const bool changed = detail::assignNearestScalar(data.data(), n, centroids.data(), k,
+                                                             labels.data(), sums.data(), counts.data());
+            for (auto kernel : kernels) {
+                std::vector<int> simdLabels = initial;
+                std::vector<double> simdSums(k, 0.0);
+                std::vector<uint64_t> simdCounts(k, 0);
+                EXPECT(kernel(data.data(), n, centroids.data(), k,
+                              simdLabels.data(), simdSums.data(), simdCounts.data()) == changed);
+                EXPECT(simdLabels == labels && simdSums == sums && simdCounts == counts);
+            }
+
+            std::sort(data.begin(), data.end());
+            std::vector<int> sortedLabels(n, 0);
+            std::fill(sums.begin(), sums.end(), 0.0);
+            std::fill(counts.begin(), counts.end(), 0);
+            detail::assignNearestScalar(data.data(), n, centroids.data(), k,
+                                        sortedLabels.data(), sums.data(), counts.data());
+            SortedAssignment1D ranges(data.data(), n);
+            ranges.assign(centroids.data(), k);
+            std::vector<int> segmentLabels(n, -1);
+            for (const auto& segment : ranges.getSegments()) {
+                std::fill(segmentLabels.begin() + segment.begin, segmentLabels.begin() + segment.end,
+                          segment.cluster);
+            }
+            EXPECT(segmentLabels == sortedLabels);
+            std::vector<double> rangeSums(k, 0.0);
+            std::vector<uint64_t> rangeCounts(k, 0);
+            ranges.accumulate(rangeSums.data(), rangeCounts.data());
+            EXPECT(rangeCounts == counts);
+            EXPECT(rangeSums == sums);
+        }
+    }
+
+    // k <= 8 scans every point, larger k assigns sorted ranges
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::vector<double> values(20000);
+    for (size_t i = 0; i < values.size(); ++i) values[i] = static_cast<double>(i % 12) * 3 + noise(rng);
+    auto dataset = std::make_shared<NumericDataset>();
+    dataset->append(values);
+    for (int k : {4, 12}) {
+        auto algorithm = AlgorithmFactory::createAlgorithm("KMeansClustering");
+        algorithm->setParameter("k", std::to_string(k));
+        EXPECT(algorithm->initialize());
+        Result result = algorithm->execute(dataset);
+        EXPECT(result.getStatus() == Result::Status::SUCCESS);
+        std::vector<double> seeds(k);
+        for (int c = 0; c < k; ++c) seeds[c] = values[c * values.size() / k];
+        int iterations = 0;
+        const std::vector<double> expected = referenceKMeans(values, seeds, 100, iterations);
+        const auto& centroids = result.getPayload().getArray("centroids");
+        EXPECT(centroids.size() == expected.size());
+        for (size_t c = 0; c < expected.size() && c < centroids.size(); ++c) {
+            EXPECT(std::abs(centroids[c] - expected[c]) < 1e-9);
+        }
+        EXPECT(result.getPayload().getScalar("iterations") == iterations);
+    }
+
+    // Missing values are skipped and reported on both paths, as in the multivariate case
+    std::vector<double> complete(100);
+    for (size_t i = 0; i < complete.size(); ++i) complete[i] = static_cast<double>(i);
+    std::vector<double> withNan = complete;
+    withNan.insert(withNan.begin() + 37, std::numeric_limits<double>::quiet_NaN());
+    auto clean = std::make_shared<NumericDataset>();
+    clean->append(complete);
+    auto missing = std::make_shared<NumericDataset>();
+    missing->append(withNan);
+    for (int k : {2, 10}) {
+        auto algorithm = AlgorithmFactory::createAlgorithm("KMeansClustering");
+        algorithm->setParameter("k", std::to_string(k));
+        EXPECT(algorithm->initialize());
+        Result expected = algorithm->execute(clean);
+        Result actual = algorithm->execute(missing);
+        EXPECT(actual.getPayload().getArray("centroids") == expected.getPayload().getArray("centroids"));
+        EXPECT(actual.getPayload().getScalar("skipped_rows") == 1);
+        EXPECT(actual.getData().find("Rows skipped for missing values: 1\n") != std::string::npos);
+        EXPECT(actual.getData().find("nan") == std::string::npos);
+        EXPECT(expected.getData().find("Rows skipped") == std::string::npos);
+    }
+}
+
+// أͷеֶζ"12abc""2024-01-01" 
+void testMatrixStrictFields() {
+    MatrixDataset header;
+    EXPECT(header.load(writeFile("test_matrix_header.csv", "1st,2nd\n1,2\n3,4\n")));
+    EXPECT(header.getColumnCount() == 2);
+    EXPECT(header.getColumnNames() == (std::vector<std::string>{"1st", "2nd"}));
+    EXPECT(header.getSize() == 2);
+    EXPECT(header.getRow(0)[0] == 1 && header.getRow(1)[1] == 4);
+
+    MatrixDataset rows;
+    EXPECT(rows.load(writeFile("test_matrix_rows.csv", "1,2\r\n12abc,3\r\n2024-01-01,5\r\n6, 7 \r\n")));
+    EXPECT(rows.getColumnNames() == (std::vector<std::string>{"column_0", "column_1"}));
+    EXPECT(rows.getSize() == 2);
+    EXPECT(rows.getSkippedLines() == 2);
+    EXPECT(rows.getMetadata("skipped_lines") == "2");
+    EXPECT(rows.getValues() == (std::vector<double>{1, 2, 6, 7}));
+}
+
+// ά k-meansAVX2 ֿںںλһ£ͬһԾͱصõͬ
+void testKMeansMultivariate() {
+    std::mt19937_64 rng(24);
+    std::vector<AssignNearestNdKernel> kernels;
+#ifdef DATAPLATFORM_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) kernels.push_back(&detail::assignNearestNdAvx2);
+#endif
+    const size_t n = 203;
+    for (size_t d : {1, 2, 3, 7}) {
+        for (size_t k : {1, 3, 4, 5, 9}) {
+            std::vector<std::vector<double>> columns(d, std::vector<double>(n));
+            std::vector<const double*> pointers;
+            for (auto& column : columns) {
+                // Small integers make exact distance ties common
+                for (double& x : column) x = static_cast<double>(rng() % 6);
+                pointers.push_back(column.data());
+            }
+            std::vector<double> centroids(k * d);
+            for (double& c : centroids) c = static_cast<double>(rng() % 12) / 2;
+            std::vector<int> initial(n);
+            for (int& label : initial) label = static_cast<int>(rng() % k);
+
+            // An odd begin leaves a scalar tail at both ends of the 8-point steps
+            const size_t begin = 3;
+            std::vector<int> labels = initial;
+            std::vector<double> sums(k * d, 0.0);
+            std::vector<uint64_t> counts(k, 0);
+            const bool changed = detail::assignNearestNdScalar(pointers.data(), d, begin, n, centroids.data(), k,
+                                                               labels.data(), sums.data(), counts.data());
+            for (auto kernel : kernels) {
+                std::vector<int> simdLabels = initial;
+                std::vector<double> simdSums(k * d, 0.0);
+                std::vector<uint64_t> simdCounts(k, 0);
+                EXPECT(kernel(pointers.data(), d, begin, n, centroids.data(), k,
+                              simdLabels.data(), simdSums.data(), simdCounts.data()) == changed);
+                EXPECT(simdLabels == labels && simdSums == sums && simdCounts == counts);
+            }
+        }
+    }
+
+    std::normal_distribution<double> noise(0.0, 0.5);
+    std::ostringstream csv;
+    csv << "x,y,z\n";
+    for (int i = 0; i < 3000; ++i) {
+        const int cluster = i % 5;
+        csv << cluster * 4 + noise(rng) << "," << (cluster % 2) * 6 + noise(rng) << "," << noise(rng) << "\n";
+    }
+    const std::string path = writeFile("test_kmeans_nd.csv", csv.str());
+    auto matrix = std::make_shared<MatrixDataset>();
+    auto table = std::make_shared<TableDataset>();
+    EXPECT(matrix->load(path));
+    EXPECT(table->load(path));
+    auto algorithm = AlgorithmFactory::createAlgorithm("KMeansClustering");
+    algorithm->setParameter("k", "5");
+    EXPECT(algorithm->initialize());
+    Result fromMatrix = algorithm->execute(matrix);
+    Result fromTable = algorithm->execute(table);
+    EXPECT(fromMatrix.getStatus() == Result::Status::SUCCESS && fromTable.getStatus() == Result::Status::SUCCESS);
+    if (fromMatrix.getStatus() != Result::Status::SUCCESS || fromTable.getStatus() != Result::Status::SUCCESS) return;
+    const ResultTable& a = fromMatrix.getPayload().getTable("centroids");
+    const ResultTable& b = fromTable.getPayload().getTable("centroids");
+    for (const char* name : {"x", "y", "z"}) {
+        EXPECT(a.getNumbers(name) == b.getNumbers(name));
+    }
+    EXPECT(fromMatrix.getPayload().getArray("cluster_sizes") == fromTable.getPayload().getArray("cluster_sizes"));
+}
+
+// һά k-meansظĳʼĵõմʱԭģɨ·һ
+void testKMeansEmptyCluster() {
+    for (int k : {3, 9}) {
+        // spaced ʼȡ 0n/k2n/k... 㣺һ 10඼ظ 5 
+        auto dataset = std::make_shared<NumericDataset>();
+        std::vector<double> values(90, 5.0);
+        std::fill(values.end() - 90 / k, values.end(), 10.0);
+        dataset->append(values);
+
+        auto algorithm = AlgorithmFactory::createAlgorithm("KMeansClustering");
+        algorithm->setParameter("k", std::to_string(k));
+        EXPECT(algorithm->initialize());
+        Result result = algorithm->execute(dataset);
+        EXPECT(result.getStatus() == Result::Status::SUCCESS);
+        const auto& centroids = result.getPayload().getArray("centroids");
+        EXPECT(centroids.size() == static_cast<size_t>(k));
+        for (size_t c = 0; c + 1 < centroids.size(); ++c) {
+            EXPECT(centroids[c] == 5.0);
+        }
+        EXPECT(!centroids.empty() && centroids.back() == 10.0);
+    }
+}
+
+// kmeans++ / kmeans|| ʼͬһӽ̶߳޹أͬѡͬĵ㣬
+void testKMeansSeeding() {
+    const size_t n = 150000;    // spans several seeding chunks
+    const int k = 6;
+    std::mt19937_64 rng(25);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::vector<double> x(n), y(n);
+    for (size_t i = 0; i < n; ++i) {
+        const int cluster = static_cast<int>(i % k);
+        x[i] = cluster * 100 + noise(rng);
+        y[i] = (cluster % 2) * 100 + noise(rng);
+    }
+    const double* columns[] = {x.data(), y.data()};
+    ThreadExecutor single(1), several(4);
+    using Seeding = std::vector<double> (KMeansSeeder::*)(size_t);
+    for (Seeding method : {&KMeansSeeder::kmeansPlusPlus, &KMeansSeeder::kmeansParallel}) {
+        auto seed = [&](IExecutor& executor, uint64_t value) {
+            KMeansSeeder seeder(columns, 2, n, executor, value);
+            return (seeder.*method)(k);
+        };
+        const std::vector<double> first = seed(single, 7);
+        EXPECT(first.size() == 2 * k);
+        EXPECT(seed(single, 7) == first);
+        EXPECT(seed(several, 7) == first);
+        EXPECT(seed(single, 8) != first);
+        if (method == &KMeansSeeder::kmeansPlusPlus) {
+            // k-means++ picks data points, and with clusters this far apart one from each cluster
+            std::vector<bool> hit(k, false);
+            for (int c = 0; c < k; ++c) {
+                const int cluster = static_cast<int>(std::lround(first[2 * c] / 100));
+                EXPECT(cluster >= 0 && cluster < k && std::abs(first[2 * c + 1] - (cluster % 2) * 100) < 10);
+                if (cluster >= 0 && cluster < k) hit[cluster] = true;
+                bool isRow = false;
+                for (size_t i = 0; i < n && !isRow; ++i) isRow = x[i] == first[2 * c] && y[i] == first[2 * c + 1];
+                EXPECT(isRow);
+            }
+            EXPECT(std::count(hit.begin(), hit.end(), true) == k);
+        }
+    }
+
+    // 1-D clustering through the algorithm converges to the six cluster means for any seed
+    auto dataset = std::make_shared<NumericDataset>();
+    dataset->append(x);
+    for (const char* init : {"kmeans++", "kmeans||"}) {
+        std::vector<double> previous;
+        for (int value = 1; value <= 3; ++value) {
+            auto algorithm = AlgorithmFactory::createAlgorithm("KMeansClustering");
+            algorithm->setParameter("k", std::to_string(k));
+            algorithm->setParameter("init", init);
+            algorithm->setParameter("seed", std::to_string(value));
+            EXPECT(algorithm->initialize());
+            Result result = algorithm->execute(dataset);
+            EXPECT(result.getStatus() == Result::Status::SUCCESS);
+            if (result.getStatus() != Result::Status::SUCCESS) continue;
+            std::vector<double> centroids = result.getPayload().getArray("centroids");
+            std::sort(centroids.begin(), centroids.end());
+            for (int c = 0; c < k; ++c) {
+                EXPECT(std::abs(centroids[c] - c * 100) < 0.1);
+            }
+            EXPECT(result.getPayload().getText("init") == init);
+            if (!previous.empty()) EXPECT(centroids == previous);
+            previous = centroids;
+        }
+    }
+    auto invalid = AlgorithmFactory::createAlgorithm("KMeansClustering");
+    invalid->setParameter("init", "random");
+    EXPECT(!invalid->initialize());
+}
+
+} // namespace
+
+int main() {
+    testNumericLoaderMatchesStod();
+    testParallelLoadMatchesSequential();
+    testBinaryRoundTrip();
+    testStatisticsKernels();
+    testAppendSelf();
+    testIqrFilterKeepsNan();
+    testPipelineParse();
+    testWordCountTableMove();
+    testWordCountsMatchStreamSplit();
+    testNormalizeTextMatchesReference();
+    testCompactTextStorage();
+    testStreamingMedianWithinBudget();
+    testAsyncReadBackends();
+    testCompressedInput();
+    testCsvQuotingAndTypes();
+    testTableNumericFields();
+    testGroupByMatchesReference();
+    testDateTimeParsing();
+    testTimeBucketWidth();
+    testDatasetViews();
+    testSnapshotIsolation();
+    testConcurrentTasksAndAppend();
+    testSamplingParameters();
+    testSamplingCoverage();
+    testTypedResultPayloads();
+    testTakeTaskResult();
+    testKMeansAssignmentPaths();
+    testMatrixStrictFields();
+    testKMeansEmptyCluster();
+    testKMeansMultivariate();
+    testKMeansSeeding();
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "All tests passed\n";
+    return 0;
+}
\ No newline at end of file
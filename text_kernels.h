@@ -0,0 +1,469 @@
+// text_kernels.h
+#ifndef TEXT_KERNELS_H
+#define TEXT_KERNELS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <memory>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace DataPlatform {
+
+//  "C" locale  std::isspace ͬĿհַ
+inline bool isAsciiSpace(unsigned char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// հзֵʣ std::istringstream >> std::string Ľһ
+template<typename Callback>
+inline void forEachWord(const char* first, const char* last, Callback&& callback) {
+    const char* p = first;
+    while (p < last) {
+        while (p < last && isAsciiSpace(static_cast<unsigned char>(*p))) ++p;
+        const char* begin = p;
+        while (p < last && !isAsciiSpace(static_cast<unsigned char>(*p))) ++p;
+        if (p != begin) {
+            callback(std::string_view(begin, static_cast<size_t>(p - begin)));
+        }
+    }
+}
+
+// ͵ع淶һı³ȣ䳤·ڴ棩
+// ASCII ĸתСдհ۵Ϊеһհַȥβհס
+// հ׵ 16 ֽڿ SSE2 ·ֽ
+inline size_t normalizeText(char* text, size_t length) {
+    size_t read = 0;
+    while (read < length && isAsciiSpace(static_cast<unsigned char>(text[read]))) ++read;
+
+    size_t write = 0;
+    bool previousSpace = false;
+    while (read < length) {
+#ifdef __SSE2__
+        if (read + 16 <= length) {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + read));
+            // Bytes >= 0x80 are negative as signed chars and never match
+            const __m128i spaces = _mm_or_si128(
+                _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')),
+                _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('\t' - 1)),
+                              _mm_cmplt_epi8(bytes, _mm_set1_epi8('\r' + 1))));
+            const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(spaces));
+            const bool hasRun = (mask & (mask << 1)) != 0 || (previousSpace && (mask & 1));
+            if (!hasRun) {
+                const __m128i upper = _mm_and_si128(
+                    _mm_cmpgt_epi8(bytes, _mm_set1_epi8('A' - 1)),
+                    _mm_cmplt_epi8(bytes, _mm_set1_epi8('Z' + 1)));
+                const __m128i lowered = _mm_or_si128(bytes, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+                // write <= read and the block is already loaded, so overlap is safe
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(text + write), lowered);
+                write += 16;
+                read += 16;
+                previousSpace = (mask & 0x8000) != 0;
+                continue;
+            }
+        }
+        const size_t blockEnd = std::min(read + 16, length);
+#else
+        const size_t blockEnd = length;
+#endif
+        for (; read < blockEnd; ++read) {
+            const unsigned char c = static_cast<unsigned char>(text[read]);
+            if (isAsciiSpace(c)) {
+                if (!previousSpace) {
+                    text[write++] = static_cast<char>(c);
+                }
+                previousSpace = true;
+            } else {
+                text[write++] = static_cast<char>((c >= 'A' && c <= 'Z') ? (c | 0x20) : c);
+                previousSpace = false;
+            }
+        }
+    }
+
+    if (write > 0 && isAsciiSpace(static_cast<unsigned char>(text[write - 1]))) {
+        --write;
+    }
+    return write;
+}
+
+// ַڴأ䣬ַڳǰַ
+class StringArena {
+private:
+    static constexpr size_t BLOCK_BYTES = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* cursor_;
+    size_t remaining_;
+    size_t bytesUsed_;
+
+public:
+    StringArena() : cursor_(nullptr), remaining_(0), bytesUsed_(0) {}
+
+    StringArena(StringArena&& other) noexcept
+        : blocks_(std::move(other.blocks_))
+        , cursor_(other.cursor_)
+        , remaining_(other.remaining_)
+        , bytesUsed_(other.bytesUsed_) {
+        other.clear();
+    }
+
+    StringArena& operator=(StringArena&& other) noexcept {
+        if (this != &other) {
+            blocks_ = std::move(other.blocks_);
+            cursor_ = other.cursor_;
+            remaining_ = other.remaining_;
+            bytesUsed_ = other.bytesUsed_;
+            other.clear();
+        }
+        return *this;
+    }
+
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    std::string_view store(std::string_view text) {
+        if (text.size() > remaining_) {
+            size_t size = std::max(BLOCK_BYTES, text.size());
+            blocks_.emplace_back(new char[size]);
+            cursor_ = blocks_.back().get();
+            remaining_ = size;
+        }
+        std::memcpy(cursor_, text.data(), text.size());
+        std::string_view stored(cursor_, text.size());
+        cursor_ += text.size();
+        remaining_ -= text.size();
+        bytesUsed_ += text.size();
+        return stored;
+    }
+
+    void clear() {
+        blocks_.clear();
+        cursor_ = nullptr;
+        remaining_ = 0;
+        bytesUsed_ = 0;
+    }
+
+    size_t getBytesUsed() const { return bytesUsed_; }
+};
+
+// ַϣÿζȡ 8 ֽڲ˷
+inline uint64_t hashString(std::string_view text) {
+    const char* p = text.data();
+    size_t n = text.size();
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ (n * 0xff51afd7ed558ccdULL);
+    while (n >= 8) {
+        uint64_t word;
+        std::memcpy(&word, p, 8);
+        h = (h ^ word) * 0xbf58476d1ce4e5b9ULL;
+        h ^= h >> 31;
+        p += 8;
+        n -= 8;
+    }
+    if (n > 0) {
+        uint64_t word = 0;
+        std::memcpy(&word, p, n);
+        h = (h ^ word) * 0x94d049bb133111ebULL;
+        h ^= h >> 29;
+    }
+    h *= 0xff51afd7ed558ccdULL;
+    return h ^ (h >> 32);
+}
+
+// ƵѰַ̽⣩ϣΪָڲ StringArena  string_view
+class WordCountTable {
+private:
+    struct Slot {
+        std::string_view word;
+        uint64_t hash;
+        size_t count;   // 0 ʾղ
+    };
+
+    std::vector<Slot> slots_;
+    size_t size_;
+    size_t totalWords_;
+    StringArena arena_;
+
+public:
+    explicit WordCountTable(size_t expectedWords = 0) : size_(0), totalWords_(0) {
+        size_t capacity = 16;
+        while (capacity < expectedWords * 2) capacity <<= 1;
+        slots_.assign(capacity, Slot{std::string_view(), 0, 0});
+    }
+
+    // ߵıûвλһſձһ add() ·
+    WordCountTable(WordCountTable&& other) noexcept
+        : slots_(std::move(other.slots_))
+        , size_(other.size_)
+        , totalWords_(other.totalWords_)
+        , arena_(std::move(other.arena_)) {
+        other.releaseSlots();
+    }
+
+    WordCountTable& operator=(WordCountTable&& other) noexcept {
+        if (this != &other) {
+            slots_ = std::move(other.slots_);
+            size_ = other.size_;
+            totalWords_ = other.totalWords_;
+            arena_ = std::move(other.arena_);
+            other.releaseSlots();
+        }
+        return *this;
+    }
+
+    WordCountTable(const WordCountTable& other) : WordCountTable(other.size_) {
+        merge(other);
+    }
+
+    WordCountTable& operator=(const WordCountTable& other) {
+        if (this != &other) {
+            WordCountTable copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    void add(std::string_view word, size_t count = 1) {
+        add(word, hashString(word), count);
+    }
+
+    // ϲһűļ
+    void merge(const WordCountTable& other) {
+        for (const Slot& slot : other.slots_) {
+            if (slot.count != 0) {
+                add(slot.word, slot.hash, slot.count);
+            }
+        }
+    }
+
+    size_t count(std::string_view word) const {
+        if (slots_.empty()) return 0;
+        const uint64_t hash = hashString(word);
+        const size_t mask = slots_.size() - 1;
+        for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+            const Slot& slot = slots_[i];
+            if (slot.count == 0) return 0;
+            if (slot.hash == hash && slot.word == word) return slot.count;
+        }
+    }
+
+    template<typename Callback>
+    void forEach(Callback&& callback) const {
+        for (const Slot& slot : slots_) {
+            if (slot.count != 0) {
+                callback(slot.word, slot.count);
+            }
+        }
+    }
+
+    // ȡǰ k ֵͬ
+    std::vector<std::pair<std::string_view, size_t>> topK(size_t k) const {
+        std::vector<std::pair<std::string_view, size_t>> entries;
+        entries.reserve(size_);
+        forEach([&entries](std::string_view word, size_t count) {
+            entries.emplace_back(word, count);
+        });
+
+        auto byFrequency = [](const auto& a, const auto& b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        };
+        k = std::min(k, entries.size());
+        std::partial_sort(entries.begin(), entries.begin() + k, entries.end(), byFrequency);
+        entries.resize(k);
+        return entries;
+    }
+
+    std::map<std::string, size_t> toOrderedMap() const {
+        std::map<std::string, size_t> ordered;
+        forEach([&ordered](std::string_view word, size_t count) {
+            ordered.emplace(std::string(word), count);
+        });
+        return ordered;
+    }
+
+    void clear() {
+        std::fill(slots_.begin(), slots_.end(), Slot{std::string_view(), 0, 0});
+        size_ = 0;
+        totalWords_ = 0;
+        arena_.clear();
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t totalWords() const { return totalWords_; }
+
+private:
+    void add(std::string_view word, uint64_t hash, size_t count) {
+        if (slots_.empty()) {
+            slots_.assign(16, Slot{std::string_view(), 0, 0});
+        }
+        totalWords_ += count;
+        size_t mask = slots_.size() - 1;
+        for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+            Slot& slot = slots_[i];
+            if (slot.count == 0) {
+                slot.word = arena_.store(word);
+                slot.hash = hash;
+                slot.count = count;
+                if (++size_ * 10 > slots_.size() * 7) {
+                    grow();
+                }
+                return;
+            }
+            if (slot.hash == hash && slot.word == word) {
+                slot.count += count;
+                return;
+            }
+        }
+    }
+
+    void releaseSlots() {
+        slots_.clear();
+        slots_.shrink_to_fit();
+        size_ = 0;
+        totalWords_ = 0;
+        arena_.clear();
+    }
+
+    void grow() {
+        std::vector<Slot> old(slots_.size() * 2, Slot{std::string_view(), 0, 0});
+        old.swap(slots_);
+        const size_t mask = slots_.size() - 1;
+        for (const Slot& slot : old) {
+            if (slot.count == 0) continue;
+            size_t i = slot.hash & mask;
+            while (slots_[i].count != 0) i = (i + 1) & mask;
+            slots_[i] = slot;
+        }
+    }
+};
+
+// д洢βӴһַУoffsets_ ¼ÿе
+// ÿֻռ 8 ֽƫʱ˳ڴ
+class LineBuffer {
+private:
+    std::vector<char> chars_;
+    std::vector<uint64_t> offsets_;   //  + 1 Ԫأoffsets_[0] == 0
+
+public:
+    LineBuffer() : offsets_(1, 0) {}
+
+    void reserve(size_t lines, size_t bytes) {
+        offsets_.reserve(lines + 1);
+        chars_.reserve(bytes);
+    }
+
+    void append(std::string_view line) {
+        chars_.insert(chars_.end(), line.begin(), line.end());
+        offsets_.push_back(chars_.size());
+    }
+
+    void append(const LineBuffer& other) {
+        const uint64_t base = chars_.size();
+        chars_.insert(chars_.end(), other.chars_.begin(), other.chars_.end());
+        offsets_.reserve(offsets_.size() + other.size());
+        for (size_t i = 1; i < other.offsets_.size(); ++i) {
+            offsets_.push_back(base + other.offsets_[i]);
+        }
+    }
+
+    std::string_view operator[](size_t index) const {
+        return std::string_view(chars_.data() + offsets_[index],
+                                static_cast<size_t>(offsets_[index + 1] - offsets_[index]));
+    }
+
+    // ͵ر任ÿһУtransform(char* data, size_t length) ³ȣñ䳤
+    // Ѹǰƣֻ
+    template<typename Transform>
+    void transformInPlace(Transform&& transform, bool dropEmpty) {
+        const size_t lines = size();
+        size_t write = 0;
+        size_t kept = 0;
+        for (size_t i = 0; i < lines; ++i) {
+            const size_t begin = static_cast<size_t>(offsets_[i]);
+            const size_t length = static_cast<size_t>(offsets_[i + 1]) - begin;
+            const size_t newLength = transform(chars_.data() + begin, length);
+            if (newLength == 0 && dropEmpty) continue;
+
+            if (write != begin) {
+                std::memmove(chars_.data() + write, chars_.data() + begin, newLength);
+            }
+            offsets_[kept++] = write;
+            write += newLength;
+        }
+        offsets_[kept] = write;
+        offsets_.resize(kept + 1);
+        chars_.resize(write);
+    }
+
+    void clear() {
+        chars_.clear();
+        offsets_.assign(1, 0);
+    }
+
+    void shrinkToFit() {
+        chars_.shrink_to_fit();
+        offsets_.shrink_to_fit();
+    }
+
+    size_t size() const { return offsets_.size() - 1; }
+    bool empty() const { return size() == 0; }
+    size_t getCharCount() const { return chars_.size(); }
+    size_t getMemoryUsage() const {
+        return chars_.capacity() + offsets_.capacity() * sizeof(uint64_t);
+    }
+};
+
+// еֻͼͳһ std::vector<std::string>  LineBuffer ִ洢
+class TextLines {
+private:
+    const std::vector<std::string>* strings_;
+    const LineBuffer* buffer_;
+
+public:
+    explicit TextLines(const std::vector<std::string>& strings)
+        : strings_(&strings), buffer_(nullptr) {}
+    explicit TextLines(const LineBuffer& buffer)
+        : strings_(nullptr), buffer_(&buffer) {}
+
+    size_t size() const { return buffer_ ? buffer_->size() : strings_->size(); }
+    bool empty() const { return size() == 0; }
+
+    std::string_view operator[](size_t index) const {
+        return buffer_ ? (*buffer_)[index] : std::string_view((*strings_)[index]);
+    }
+
+    class iterator {
+    private:
+        const TextLines* lines_;
+        size_t index_;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::string_view;
+
+        iterator(const TextLines* lines, size_t index) : lines_(lines), index_(index) {}
+        std::string_view operator*() const { return (*lines_)[index_]; }
+        iterator& operator++() { ++index_; return *this; }
+        bool operator==(const iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const iterator& other) const { return index_ != other.index_; }
+    };
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, size()); }
+};
+
+} // namespace DataPlatform
+
+#endif // TEXT_KERNELS_H
\ No newline at end of file